@@ -0,0 +1,473 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "fixed_url.hpp"
+#include "url.hpp"
+#include "url_corpus.hpp"
+#include "url_sort.hpp"
+#include "url_syntax_exception.hpp"
+
+//Throughput benchmarks for the public paths of bundle::Url: parsing, relative resolution,
+//serialization and comparison. For every case it reports URLs/s, MB/s (of the URL text consumed
+//or produced) and heap allocations per operation. Options:
+//  --min-time <seconds>  Minimum measuring time per case (default 0.5).
+//  --count <n>           Size of each generated corpus (default 10000). The sort/*-mixed-large
+//                        cases use at least 262144 URLs, so that SortUrls runs in parallel.
+//  --seed <n>            Seed for the corpus generator (default 2009).
+//  --filter <text>       Only run cases whose name contains the text.
+//  --corpus <file>       Also parse the URLs in the file (one per line), e.g. from url_corpus_gen.
+//  --resolve-corpus <file>
+//                        Also resolve the references in the file against the base URL on its
+//                        first line, e.g. from url_corpus_gen deep.
+
+
+//Allocations are counted by replacing the global allocation functions of this program.
+namespace
+{
+std::atomic<unsigned long long> allocation_count(0);
+}
+
+void* operator new(std::size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+//Results are folded into this so the optimizer cannot discard the measured work.
+volatile std::size_t sink = 0;
+
+struct Options
+{
+  double min_time;
+  std::size_t count;
+  unsigned long long seed;
+  std::string filter;
+  std::string corpus_file;
+  std::string resolve_corpus_file;
+};
+
+struct Result
+{
+  unsigned long long operations;
+  unsigned long long bytes;
+  unsigned long long allocations;
+  double seconds;
+};
+
+//Runs op(i) for i cycling through [0, items) until at least min_time seconds have passed. The
+//op returns the number of bytes it processed. A first untimed pass warms up caches and the
+//allocator.
+template <class Op>
+Result Measure(std::size_t items, double min_time, Op op)
+{
+  for (std::size_t i = 0; i < items; ++i)
+    op(i);
+
+  Result result = { 0, 0, 0, 0.0 };
+  unsigned long long allocations = allocation_count.load(std::memory_order_relaxed);
+  Clock::time_point start = Clock::now();
+  do
+  {
+    for (std::size_t i = 0; i < items; ++i)
+      result.bytes += op(i);
+    result.operations += items;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (result.seconds < min_time);
+  result.allocations = allocation_count.load(std::memory_order_relaxed) - allocations;
+  return result;
+}
+
+void PrintHeader()
+{
+  std::printf("%-28s %12s %14s %10s %12s\n", "case", "ns/op", "URLs/s", "MB/s", "allocs/op");
+}
+
+void PrintResult(char const* name, Result const& result)
+{
+  double ops = static_cast<double>(result.operations);
+  std::printf("%-28s %12.1f %14.0f %10.1f %12.2f\n",
+              name,
+              result.seconds * 1e9 / ops,
+              ops / result.seconds,
+              result.bytes / result.seconds / 1e6,
+              result.allocations / ops);
+}
+
+template <class Op>
+void Run(Options const& options, char const* name, std::size_t items, Op op)
+{
+  if (!options.filter.empty() && std::strstr(name, options.filter.c_str()) == 0)
+    return;
+  if (items == 0)
+    return;
+  PrintResult(name, Measure(items, options.min_time, op));
+}
+
+//For operations over a whole collection: measured once per collection, reported per URL.
+template <class Op>
+void RunBulk(Options const& options, char const* name, std::size_t items, Op op)
+{
+  if (!options.filter.empty() && std::strstr(name, options.filter.c_str()) == 0)
+    return;
+  if (items == 0)
+    return;
+  Result result = Measure(1, options.min_time, op);
+  result.operations *= items;
+  PrintResult(name, result);
+}
+
+//Times std::sort and SortUrls over the URLs (copying them included, since both sort in place),
+//after making sure both produce the same order.
+bool RunSorts(Options const& options, char const* corpus, std::vector<bundle::Url> const& urls)
+{
+  std::string std_name = std::string("sort/std-") + corpus;
+  std::string radix_name = std::string("sort/radix-") + corpus;
+  if (!options.filter.empty() && std_name.find(options.filter) == std::string::npos &&
+      radix_name.find(options.filter) == std::string::npos)
+    return true;
+
+  std::vector<bundle::Url> expected(urls);
+  std::sort(expected.begin(), expected.end());
+  std::vector<bundle::Url> sorted(urls);
+  bundle::SortUrls(sorted);
+  if (sorted != expected)
+  {
+    std::cerr << radix_name << ": SortUrls disagrees with std::sort" << std::endl;
+    return false;
+  }
+
+  std::size_t bytes = 0;
+  for (std::size_t i = 0; i < urls.size(); ++i)
+    bytes += urls[i].ToString().size();
+
+  RunBulk(options, std_name.c_str(), urls.size(), [&](std::size_t) -> std::size_t {
+    std::vector<bundle::Url> copy(urls);
+    std::sort(copy.begin(), copy.end());
+    sink = sink + copy[0].get_port();
+    return bytes;
+  });
+
+  RunBulk(options, radix_name.c_str(), urls.size(), [&](std::size_t) -> std::size_t {
+    std::vector<bundle::Url> copy(urls);
+    bundle::SortUrls(copy);
+    sink = sink + copy[0].get_port();
+    return bytes;
+  });
+  return true;
+}
+
+void RunParse(Options const& options, char const* name, std::vector<std::string> const& corpus)
+{
+  Run(options, name, corpus.size(), [&corpus](std::size_t i) -> std::size_t {
+    bundle::Url url(corpus[i]);
+    sink = sink + url.get_path().size();
+    return corpus[i].size();
+  });
+}
+
+void RunResolve(Options const& options,
+                char const* name,
+                bundle::Url const& base,
+                std::vector<std::string> const& references)
+{
+  Run(options, name, references.size(), [&base, &references](std::size_t i) -> std::size_t {
+    bundle::Url url(base, references[i]);
+    sink = sink + url.get_path().size();
+    return references[i].size();
+  });
+}
+
+//Reference examples from section 5.4 of RFC 3986, resolved against "http://a/b/c/d;p?q".
+char const* const normal_examples[] = {
+  "g:h", "g", "./g", "g/", "/g", "//g", "?y", "g?y", "#s", "g#s", "g?y#s", ";x", "g;x",
+  "g;x?y#s", "", ".", "./", "..", "../", "../g", "../..", "../../", "../../g"
+};
+
+char const* const abnormal_examples[] = {
+  "../../../g", "../../../../g", "/./g", "/../g", "g.", ".g", "g..", "..g", "./../g", "./g/.",
+  "g/./h", "g/../h", "g;x=1/./y", "g;x=1/../y", "g?y/./x", "g?y/../x", "g#s/./x", "g#s/../x",
+  "http:g"
+};
+
+template <std::size_t N>
+std::vector<std::string> ToVector(char const* const (&examples)[N])
+{
+  return std::vector<std::string>(examples, examples + N);
+}
+
+bool ParseOptions(int argc, char* argv[], Options & options)
+{
+  options.min_time = 0.5;
+  options.count = 10000;
+  options.seed = 2009;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg(argv[i]);
+    if (i + 1 == argc)
+    {
+      std::cerr << "missing value for option: " << arg << std::endl;
+      return false;
+    }
+    char const* value = argv[++i];
+    if (arg == "--min-time")
+      options.min_time = std::strtod(value, 0);
+    else if (arg == "--count")
+      options.count = std::strtoul(value, 0, 10);
+    else if (arg == "--seed")
+      options.seed = std::strtoull(value, 0, 10);
+    else if (arg == "--filter")
+      options.filter = value;
+    else if (arg == "--corpus")
+      options.corpus_file = value;
+    else if (arg == "--resolve-corpus")
+      options.resolve_corpus_file = value;
+    else
+    {
+      std::cerr << "unknown option: " << arg << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//Reads one URL per line, dropping those the parser rejects (they would abort the measurement).
+bool LoadCorpus(std::string const& file, std::vector<std::string> & corpus)
+{
+  std::ifstream in(file.c_str());
+  if (!in)
+    return false;
+
+  std::size_t rejected = 0;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (line.empty())
+      continue;
+    try
+    {
+      bundle::Url url(line);
+      corpus.push_back(line);
+    }
+    catch (bundle::UrlSyntaxException const&)
+    {
+      ++rejected;
+    }
+  }
+  if (rejected)
+    std::cerr << "skipped " << rejected << " unparsable URLs from " << file << std::endl;
+  return true;
+}
+
+//Reads the base URL from the first line and one reference per line after it, dropping the
+//references that can't be resolved.
+bool LoadResolveCorpus(std::string const& file,
+                       std::string & base,
+                       std::vector<std::string> & references)
+{
+  std::ifstream in(file.c_str());
+  if (!in || !std::getline(in, base))
+    return false;
+
+  try
+  {
+    bundle::Url context(base);
+    std::size_t rejected = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+      try
+      {
+        bundle::Url url(context, line);
+        references.push_back(line);
+      }
+      catch (bundle::UrlSyntaxException const&)
+      {
+        ++rejected;
+      }
+    }
+    if (rejected)
+      std::cerr << "skipped " << rejected << " unresolvable references from " << file << std::endl;
+  }
+  catch (bundle::UrlSyntaxException const&)
+  {
+    std::cerr << "unparsable base URL in " << file << ": " << base << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} //Anonymous namespace.
+
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options))
+    return 1;
+
+  bundle::UrlCorpusGenerator generator(options.seed);
+  std::vector<std::string> short_urls =
+    generator.Generate(bundle::UrlCorpusGenerator::SHORT_URLS, options.count);
+  std::vector<std::string> long_urls =
+    generator.Generate(bundle::UrlCorpusGenerator::LONG_URLS, options.count);
+  std::vector<std::string> ipv6_urls =
+    generator.Generate(bundle::UrlCorpusGenerator::IPV6_URLS, options.count);
+  std::vector<std::string> opaque_urls =
+    generator.Generate(bundle::UrlCorpusGenerator::OPAQUE_URLS, options.count);
+  std::vector<std::string> mixed_urls =
+    generator.Generate(bundle::UrlCorpusGenerator::MIXED_URLS, options.count);
+
+  const std::size_t depth = 16;
+  bundle::Url deep_base(generator.GenerateDeepBase(depth));
+  std::vector<std::string> deep_references =
+    generator.GenerateDeepDotSegments(options.count, depth);
+
+  std::vector<std::string> file_urls;
+  if (!options.corpus_file.empty() && !LoadCorpus(options.corpus_file, file_urls))
+  {
+    std::cerr << "cannot read corpus: " << options.corpus_file << std::endl;
+    return 1;
+  }
+
+  std::string file_base("file:");
+  std::vector<std::string> file_references;
+  if (!options.resolve_corpus_file.empty() &&
+      !LoadResolveCorpus(options.resolve_corpus_file, file_base, file_references))
+  {
+    std::cerr << "cannot read corpus: " << options.resolve_corpus_file << std::endl;
+    return 1;
+  }
+
+  PrintHeader();
+
+  //Parsing.
+  RunParse(options, "parse/short", short_urls);
+  RunParse(options, "parse/long", long_urls);
+  RunParse(options, "parse/ipv6", ipv6_urls);
+  RunParse(options, "parse/opaque", opaque_urls);
+  RunParse(options, "parse/mixed", mixed_urls);
+  RunParse(options, "parse/file", file_urls);
+
+  Run(options, "parse/fixed-short", short_urls.size(), [&short_urls](std::size_t i) -> std::size_t {
+    bundle::FixedUrl url(short_urls[i]);
+    sink = sink + url.get_path().size();
+    return short_urls[i].size();
+  });
+
+  //Relative resolution.
+  bundle::Url rfc_base("http://a/b/c/d;p?q");
+  RunResolve(options, "resolve/rfc3986-normal", rfc_base, ToVector(normal_examples));
+  RunResolve(options, "resolve/rfc3986-abnormal", rfc_base, ToVector(abnormal_examples));
+  RunResolve(options, "resolve/deep-dot-segments", deep_base, deep_references);
+  RunResolve(options, "resolve/file", bundle::Url(file_base), file_references);
+
+  //Serialization and comparison work on already parsed URLs.
+  std::vector<bundle::Url> parsed(mixed_urls.begin(), mixed_urls.end());
+  std::vector<bundle::Url> copies(parsed);
+
+  std::vector<bundle::FixedUrl> fixed;
+  std::vector<std::size_t> fixed_sizes;
+  for (std::size_t i = 0; i < mixed_urls.size(); ++i)
+  {
+    try
+    {
+      fixed.push_back(bundle::FixedUrl(mixed_urls[i]));
+      fixed_sizes.push_back(mixed_urls[i].size());
+    }
+    catch (bundle::UrlCapacityException const&)
+    {
+      //Too long, stays a Url.
+    }
+  }
+
+  Run(options, "copy/mixed", parsed.size(), [&](std::size_t i) -> std::size_t {
+    bundle::Url url(parsed[i]);
+    sink = sink + url.get_port();
+    return mixed_urls[i].size();
+  });
+
+  //Copied into ring slots, like a router would, so the copy cannot be optimized away.
+  std::vector<bundle::FixedUrl> ring(64);
+  Run(options, "copy/fixed-mixed", fixed.size(), [&](std::size_t i) -> std::size_t {
+    ring[i % ring.size()] = fixed[i];
+    return fixed_sizes[i];
+  });
+
+  Run(options, "tostring/mixed", parsed.size(), [&parsed](std::size_t i) -> std::size_t {
+    std::string text = parsed[i].ToString();
+    sink = sink + text[0];
+    return text.size();
+  });
+
+  Run(options, "equal/same", parsed.size(), [&](std::size_t i) -> std::size_t {
+    sink = sink + (parsed[i] == copies[i]);
+    return mixed_urls[i].size() * 2;
+  });
+
+  Run(options, "equal/different", parsed.size(), [&](std::size_t i) -> std::size_t {
+    std::size_t j = (i + 1) % parsed.size();
+    sink = sink + (parsed[i] == copies[j]);
+    return mixed_urls[i].size() + mixed_urls[j].size();
+  });
+
+  //Same host, with paths sharing a long prefix, as on a crawl frontier.
+  std::vector<bundle::Url> shared_prefix;
+  for (std::size_t i = 0; i < short_urls.size(); ++i)
+    shared_prefix.push_back(bundle::Url("http://www.example.com/" + std::string(400, 'p') +
+                                        short_urls[i].substr(short_urls[i].find("//") + 2)));
+
+  //SortUrls only goes parallel on runs of 65536 URLs or more, which --count rarely reaches.
+  std::size_t large_count = std::max<std::size_t>(options.count, 1 << 18);
+  std::vector<std::string> large_urls =
+    generator.Generate(bundle::UrlCorpusGenerator::MIXED_URLS, large_count);
+  std::vector<bundle::Url> large(large_urls.begin(), large_urls.end());
+
+  if (!RunSorts(options, "mixed", parsed) ||
+      !RunSorts(options, "shared-prefix", shared_prefix) ||
+      !RunSorts(options, "mixed-large", large))
+    return 1;
+
+  return 0;
+}
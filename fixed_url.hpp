@@ -0,0 +1,284 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#ifndef FIXED_URL_HPP
+#define FIXED_URL_HPP
+
+#include "config.hpp"
+#include "url.hpp"
+#include "url_capacity_exception.hpp"
+#include "url_parser.hpp"
+#include "url_syntax_exception.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+BUNDLE_NAMESPACE_BEGIN
+
+/*
+ * Class template BasicFixedUrl
+ *
+ * Same as Url, but the whole URL lives in an inline buffer of N characters, with the components
+ * kept as offsets into it. Neither parsing nor copying touches the heap (the class is trivially
+ * copyable). A URL that doesn't fit raises a UrlCapacityException, so the caller can fall back to
+ * a Url. A malformed one raises a UrlSyntaxException (of which the former is a kind), as in Url.
+ *
+ * Relative resolution is not offered. Resolve with Url and convert the result instead.
+ */
+
+
+template <std::size_t N>
+class BasicFixedUrl
+{
+public:
+  //An empty URL, so instances can sit in preallocated slots.
+  BasicFixedUrl();
+  BasicFixedUrl(std::string_view representation);
+  BasicFixedUrl(std::string const& representation);
+  BasicFixedUrl(char const* representation);
+  explicit BasicFixedUrl(Url const& url);
+
+
+  //Acessors.
+  std::string_view get_scheme() const { return this->View(scheme_); }
+  std::string_view get_authority() const { return this->View(authority_); }
+  std::string_view get_user_info() const { return this->View(user_info_); }
+  std::string_view get_host() const { return this->View(host_); }
+  int get_port() const { return port_; }
+  std::string_view get_path() const { return this->View(path_); }
+  std::string_view get_query() const { return this->View(query_); }
+  std::string_view get_fragment() const { return this->View(fragment_); }
+
+  static constexpr std::size_t capacity() { return N; }
+
+  std::string ToString() const;
+  Url ToUrl() const;
+
+private:
+  typedef typename std::conditional<(N <= 0xFFFF), std::uint16_t, std::uint32_t>::type Offset;
+
+  struct Span
+  {
+    Offset begin;
+    Offset size;
+  };
+
+  std::string_view View(Span span) const
+  {
+    return std::string_view(buffer_ + span.begin, span.size);
+  }
+  Span SpanOf(std::string_view component, char const* base) const;
+  Span Append(std::string_view component);
+  static Span Within(Span outer, std::size_t offset, std::size_t size);
+  static void CheckCapacity(std::size_t size);
+
+  Span scheme_;
+  Span authority_;
+  Span user_info_;
+  Span host_;
+  int port_; //-1 indicates default port.
+  Span path_;
+  Span query_;
+  Span fragment_;
+  Offset size_;
+  char buffer_[N];
+};
+
+//Fits practically every URL seen by a web server or crawler.
+typedef BasicFixedUrl<256> FixedUrl;
+
+
+template <std::size_t N>
+BasicFixedUrl<N>::BasicFixedUrl() :
+  scheme_(), authority_(), user_info_(), host_(), port_(-1), path_(), query_(), fragment_(),
+  size_(0)
+{
+}
+
+template <std::size_t N>
+BasicFixedUrl<N>::BasicFixedUrl(std::string_view representation) : port_(-1), size_(0)
+{
+  //All components are substrings of the representation. So it's parsed in place first (nothing
+  //is written if it's malformed) and then stored verbatim, with the offsets rebased on the copy.
+  UrlParser::Components components;
+  UrlParser::Execute(representation, components, false);
+
+  CheckCapacity(representation.size());
+  std::memcpy(buffer_, representation.data(), representation.size());
+  size_ = static_cast<Offset>(representation.size());
+
+  char const* base = representation.data();
+  scheme_ = this->SpanOf(components.scheme, base);
+  authority_ = this->SpanOf(components.authority, base);
+  user_info_ = this->SpanOf(components.user_info, base);
+  host_ = this->SpanOf(components.host, base);
+  port_ = components.port;
+  path_ = this->SpanOf(components.path, base);
+  query_ = this->SpanOf(components.query, base);
+  fragment_ = this->SpanOf(components.fragment, base);
+}
+
+template <std::size_t N>
+BasicFixedUrl<N>::BasicFixedUrl(std::string const& representation) :
+  BasicFixedUrl(std::string_view(representation))
+{
+}
+
+template <std::size_t N>
+BasicFixedUrl<N>::BasicFixedUrl(char const* representation) :
+  BasicFixedUrl(std::string_view(representation))
+{
+}
+
+template <std::size_t N>
+BasicFixedUrl<N>::BasicFixedUrl(Url const& url) : port_(url.get_port()), size_(0)
+{
+  //User info and host are normally inside the authority, so they are kept as spans into it. Only
+  //a Url built from components (not parsed) may have them elsewhere, and then they are stored on
+  //their own.
+  std::string const& authority = url.get_authority();
+  std::size_t user_info_at = authority.find(url.get_user_info());
+  std::size_t host_at = authority.find(url.get_host());
+  CheckCapacity(url.get_scheme().size() + authority.size() + url.get_path().size() +
+                url.get_query().size() + url.get_fragment().size() +
+                (user_info_at == std::string::npos ? url.get_user_info().size() : 0) +
+                (host_at == std::string::npos ? url.get_host().size() : 0));
+
+  scheme_ = this->Append(url.get_scheme());
+  authority_ = this->Append(authority);
+  user_info_ = user_info_at == std::string::npos ?
+    this->Append(url.get_user_info()) : this->Within(authority_, user_info_at,
+                                                     url.get_user_info().size());
+  host_ = host_at == std::string::npos ?
+    this->Append(url.get_host()) : this->Within(authority_, host_at, url.get_host().size());
+  path_ = this->Append(url.get_path());
+  query_ = this->Append(url.get_query());
+  fragment_ = this->Append(url.get_fragment());
+}
+
+template <std::size_t N>
+std::string
+BasicFixedUrl<N>::ToString() const
+{
+  std::string text;
+  text.reserve(scheme_.size + authority_.size + path_.size + query_.size + fragment_.size + 5);
+  text.append(this->get_scheme()).append(1, ':');
+  if (authority_.size)
+    text.append("//").append(this->get_authority());
+  text.append(this->get_path());
+  if (query_.size)
+    text.append(1, '?').append(this->get_query());
+  if (fragment_.size)
+    text.append(1, '#').append(this->get_fragment());
+  return text;
+}
+
+template <std::size_t N>
+Url
+BasicFixedUrl<N>::ToUrl() const
+{
+  return Url(this->ToString());
+}
+
+template <std::size_t N>
+typename BasicFixedUrl<N>::Span
+BasicFixedUrl<N>::SpanOf(std::string_view component, char const* base) const
+{
+  //Empty components may be default constructed views, which point nowhere.
+  Span span = { 0, 0 };
+  if (!component.empty())
+  {
+    span.begin = static_cast<Offset>(component.data() - base);
+    span.size = static_cast<Offset>(component.size());
+  }
+  return span;
+}
+
+template <std::size_t N>
+typename BasicFixedUrl<N>::Span
+BasicFixedUrl<N>::Append(std::string_view component)
+{
+  Span span = { size_, static_cast<Offset>(component.size()) };
+  std::memcpy(buffer_ + size_, component.data(), component.size());
+  size_ = static_cast<Offset>(size_ + component.size());
+  return span;
+}
+
+template <std::size_t N>
+typename BasicFixedUrl<N>::Span
+BasicFixedUrl<N>::Within(Span outer, std::size_t offset, std::size_t size)
+{
+  Span span = { static_cast<Offset>(outer.begin + offset), static_cast<Offset>(size) };
+  return span;
+}
+
+template <std::size_t N>
+void
+BasicFixedUrl<N>::CheckCapacity(std::size_t size)
+{
+  if (size > N)
+    throw UrlCapacityException("URL exceeds the capacity of BasicFixedUrl.");
+}
+
+template <std::size_t N>
+bool operator==(BasicFixedUrl<N> const& one, BasicFixedUrl<N> const& other)
+{
+  return one.get_scheme() == other.get_scheme() &&
+    one.get_authority() == other.get_authority() &&
+    one.get_user_info() == other.get_user_info() &&
+    one.get_host() == other.get_host() &&
+    one.get_port() == other.get_port() &&
+    one.get_path() == other.get_path() &&
+    one.get_query() == other.get_query();
+    //Fragment is not taken into consideration.
+}
+
+template <std::size_t N>
+bool operator!=(BasicFixedUrl<N> const& one, BasicFixedUrl<N> const& other)
+{
+  return !(one == other);
+}
+
+template <std::size_t N>
+std::ostream & operator<<(std::ostream & out, BasicFixedUrl<N> const& url)
+{
+  out << url.get_scheme() << ":";
+  if (!url.get_authority().empty())
+    out << "//" << url.get_authority();
+  out << url.get_path();
+  if (!url.get_query().empty())
+    out << "?" << url.get_query();
+  if (!url.get_fragment().empty())
+    out << "#" << url.get_fragment();
+  return out;
+}
+
+
+NAMESPACE_END
+
+#endif //FIXED_URL_HPP
@@ -23,14 +23,65 @@
 *****************************************************************************/
 
 #include "url.hpp"
-#include "url_syntax_exception.hpp"
-#include <cstdlib>
+#include "url_parser.hpp"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <utility>
 
 BUNDLE_NAMESPACE_BEGIN
 
+namespace
+{
+
+//Compares the labels of both hosts from right to left. A host whose labels are a suffix of the
+//other's comes first (example.com < www.example.com).
+int CompareReversedHostLabels(std::string_view one, std::string_view other)
+{
+  std::size_t one_end = one.size();
+  std::size_t other_end = other.size();
+  while (true)
+  {
+    std::size_t one_dot = one_end == 0 ? std::string_view::npos : one.rfind('.', one_end - 1);
+    std::size_t other_dot =
+      other_end == 0 ? std::string_view::npos : other.rfind('.', other_end - 1);
+    std::size_t one_begin = one_dot == std::string_view::npos ? 0 : one_dot + 1;
+    std::size_t other_begin = other_dot == std::string_view::npos ? 0 : other_dot + 1;
+
+    if (int result = one.substr(one_begin, one_end - one_begin).compare(
+          other.substr(other_begin, other_end - other_begin)))
+      return result;
+
+    if (one_dot == std::string_view::npos || other_dot == std::string_view::npos)
+      return (one_dot == std::string_view::npos ? 0 : 1) -
+        (other_dot == std::string_view::npos ? 0 : 1);
+
+    one_end = one_dot;
+    other_end = other_dot;
+  }
+}
+
+int Compare(Url const& one, Url const& other)
+{
+  if (int result = one.get_scheme().compare(other.get_scheme()))
+    return result;
+  if (int result = CompareReversedHostLabels(one.get_host(), other.get_host()))
+    return result;
+  if (one.get_port() != other.get_port())
+    return one.get_port() < other.get_port() ? -1 : 1;
+  if (int result = one.get_path().compare(other.get_path()))
+    return result;
+  if (int result = one.get_query().compare(other.get_query()))
+    return result;
+  //User info and authority are compared last, only to break ties, so that two URLs are equivalent
+  //exactly when operator== says they are.
+  if (int result = one.get_user_info().compare(other.get_user_info()))
+    return result;
+  return one.get_authority().compare(other.get_authority());
+}
+
+} //Anonymous namespace.
+
 const std::string Url::sds = "/./";
 const std::string Url::sdds = "/../";
 const std::string::const_iterator Url::sds_begin = Url::sds.begin();
@@ -39,50 +90,56 @@ const std::string::const_iterator Url::sdds_begin = Url::sdds.begin();
 const std::string::const_iterator Url::sdds_end = Url::sdds.end();
 
 
-Url::Url(std::string const& representation) : port_(-1)
+Url::Url(std::string_view representation)
+{
+  UrlParser::Components components;
+  UrlParser::Execute(representation, components, false);
+
+  scheme_ = components.scheme;
+  this->SetAuthority(components.authority, components.user_info, components.host,
+                     components.port);
+  path_ = components.path;
+  query_ = components.query;
+  fragment_ = components.fragment;
+}
+
+Url::Url(std::string const& representation) : Url(std::string_view(representation))
+{
+}
+
+Url::Url(char const* representation) : Url(std::string_view(representation))
 {
-  UrlParser::Execute(representation,
-    scheme_,
-    authority_,
-    user_info_,
-    host_,
-    port_,
-    path_,
-    query_,
-    fragment_,
-    false);
 }
 
-Url::Url(std::string const& scheme,
-         std::string const& host,
-         std::string const& path,
-         std::string const& query,
-         std::string const& fragment) :
-  scheme_(scheme), authority_(host), host_(host), port_(-1), path_(path), query_(query),
-  fragment_(fragment)
+Url::Url(std::string scheme,
+         std::string host,
+         std::string path,
+         std::string query,
+         std::string fragment) :
+  scheme_(std::move(scheme)), authority_(host), host_(std::move(host)), port_(-1),
+  path_(std::move(path)), query_(std::move(query)), fragment_(std::move(fragment))
 {
 }
 
-Url::Url(std::string const& scheme,
-         std::string const& host,
+Url::Url(std::string scheme,
+         std::string host,
          int port,
-         std::string const& path,
-         std::string const& query,
-         std::string const& fragment) :
-  scheme_(scheme), host_(host), port_(port), path_(path), query_(query), fragment_(fragment)
+         std::string path,
+         std::string query,
+         std::string fragment) :
+  scheme_(std::move(scheme)), host_(std::move(host)), port_(port), path_(std::move(path)),
+  query_(std::move(query)), fragment_(std::move(fragment))
 {
-  std::stringstream ss;
-  ss << port;
-  authority_ = host + ":" + ss.str();
+  authority_ = host_ + ":" + std::to_string(port);
 }
 
-Url::Url(Url const& context, std::string const& representation) :
-  scheme_(context.scheme_), authority_(context.authority_), user_info_(context.user_info_),
-  host_(context.host_), port_(context.port_), path_(context.path_), query_(context.query_),
-  fragment_(context.fragment_)
+Url::Url(Url const& context, std::string_view representation) : port_(-1)
 {
   if (representation.empty())
-    return; //Simply inherit from context.
+  {
+    *this = context; //Simply inherit from context.
+    return;
+  }
 
   this->ResolveRelativeness(context, representation);
 }
@@ -144,204 +201,71 @@ Url::ToString() const
 }
 
 void
-Url::UrlParser::Execute(std::string const& representation,
-                        std::string & scheme,
-                        std::string & authority,
-                        std::string & user_info,
-                        std::string & host,
-                        int & port,
-                        std::string & path,
-                        std::string & query,
-                        std::string & fragment,
-                        bool relative_resolution)
-{
-  std::size_t current_pos = 0;
-
-  //Scheme...
-  UrlParser::ExtractScheme(representation, scheme, current_pos, relative_resolution);
-
-  //Authority...
-  UrlParser::ExtractAuthority(representation, authority, user_info, host, port, current_pos);
-
-  if (current_pos == std::string::npos)
-    //In this case, the authority exists. However the URL has no path, query or fragment.
-    return;
-
-  //Path, query and fragment... (Notice that the initial slash is part of the path.)
-  std::size_t question_pos = representation.find('?', current_pos);
-  std::size_t square_pos = representation.find('#', current_pos);
-
-  if (question_pos != std::string::npos)
-  {
-    path = representation.substr(current_pos, question_pos - current_pos);
-    current_pos = question_pos + 1;
-    query = representation.substr(current_pos, square_pos - current_pos); //If square_pos
-      //is valid, the string is extracted as usual. Otherwise, just take it till the end anyway.
-      //Since the fragment is the last possible part of a URL, this behavior would be OK.
-  }
-  else
-    //The square_pos might be invalid here. However, for the same reason as above, taking the
-    //string till the end would be OK.
-    path = representation.substr(current_pos, square_pos - current_pos);
-
-  if (square_pos != std::string::npos)
-    fragment = representation.substr(square_pos + 1);
-}
-
-void
-Url::UrlParser::ExtractScheme(std::string const& representation,
-                              std::string & scheme,
-                              std::size_t & current_pos,
-                              bool relative_resolution)
+Url::ResolveRelativeness(Url const& context, std::string_view representation)
 {
-  //A scheme may or may not exist in a relative reference. In addition, according to section 4.2
-  //of RFC3986, the first path part of a relative reference may contain a colon. However, in this
-  //case it must start with a dot-segment (so it's not mistaken for a scheme name).
-  if (representation[0] == '.')
+  UrlParser::Components components;
+  UrlParser::Execute(representation, components, true);
+
+  //This is the algorithm described in section 5.2.2 of RFC 3986. Only the components the branch
+  //inherits are copied from the context (base) URL. The components are views into the
+  //representation, so each one is copied only once, straight into its member. Only the path needs
+  //a scratch copy for dot-segment removal.
+  std::string_view path = components.path;
+  if (!components.scheme.empty())
   {
-    //There's no scheme to extract. Can only be a relative reference.
-    if (!relative_resolution)
-      throw UrlSyntaxException("Dot-segment preceding a scheme?");
-    else
-      return;
+    scheme_ = components.scheme;
+    this->SetAuthority(components.authority, components.user_info, components.host,
+                       components.port);
+    this->SetPathFromReferenceRemovingDotSegments(std::string(path));
+    query_ = components.query;
   }
   else
   {
-    if ((current_pos = representation.find(':')) == std::string::npos)
-      if (!relative_resolution)
-        throw UrlSyntaxException("Scheme not found.");
-      else
-      {
-        current_pos = 0;
-        return;
-      }
-  }
-
-  scheme = representation.substr(0, current_pos++);
-  if (scheme.empty())
-    throw UrlSyntaxException("Scheme is empty.");
-}
-
-void
-Url::UrlParser::ExtractAuthority(std::string const& representation,
-                                 std::string & authority,
-                                 std::string & user_info,
-                                 std::string & host,
-                                 int & port,
-                                 std::size_t & current_pos)
-{
-  //Depending on the scheme, an authority may or may not exist (both for absolute URLs or for
-  //relative references). But when it exists, it's always preceded by the double-slash.
-  if (representation[current_pos] != '/' || representation[current_pos + 1] != '/')
-    //No authority. An URL like mailto:John.Doe@example.com or news:comp.lang.c++.
-    return;
-
-  std::size_t pos1 = current_pos + 2;
-
-  //Try to find a separator. First using slash, then question mark, then square. If none is found,
-  //take till the end of the string.
-  if ((current_pos = representation.find('/', pos1)) == std::string::npos &&
-      (current_pos = representation.find('?', pos1)) == std::string::npos)
-    current_pos = representation.find('#', pos1);
-  authority = representation.substr(pos1, current_pos - pos1);
-
-  if (authority.empty())
-    throw UrlSyntaxException("Authority is empty.");
-
-  //User info, host and port...
-  if ((pos1 = authority.find('@')) != std::string::npos)
-    user_info = authority.substr(0, pos1);
-
-  std::size_t pos2 = (pos1 == std::string::npos ? 0 : pos1 + 1); //0 or make it past the @.
-
-  //If host is surrounded by square brackets, it's an IP-literal (probably IPv6).
-  if (authority[pos2] == '[')
-  {
-    if ((pos1 = authority.find(']')) == std::string::npos)
-      throw UrlSyntaxException("Unmatched square bracket in IP-literal.");
-
-    if ((pos1 = authority.find(':', pos1)) != std::string::npos)
-      port = atoi(authority.substr(pos1 + 1).c_str());
-  }
-  else
-    if ((pos1 = authority.find(':', pos2)) != std::string::npos)
-      port = atoi(authority.substr(pos1 + 1).c_str());
-
-  host = authority.substr(pos2, pos1 - pos2);
-}
-
-void
-Url::ResolveRelativeness(Url const& context, std::string const& representation)
-{
-  std::string scheme;
-  std::string authority;
-  std::string user_info;
-  std::string host;
-  int port = -1;
-  std::string path;
-  std::string query;
-  std::string fragment;
-
-  UrlParser::Execute(representation,
-    scheme,
-    authority,
-    user_info,
-    host,
-    port,
-    path,
-    query,
-    fragment,
-    true);
-
-  //This is the algorithm described in section 5.2.2 of RFC 3986. Except for when values are
-  //inherited from the context (base) URL. In this case, they were already initialized in the
-  //constructor.
-  if (!scheme.empty())
-  {
-    scheme_ = scheme;
-    this->SetAuthority(authority, user_info, host, port);
-    this->SetPathFromReferenceRemovingDotSegments(path);
-    query_ = query;
-  }
-  else
-  {
-    if (!authority.empty())
+    if (!components.authority.empty())
     {
-      this->SetAuthority(authority, user_info, host, port);
-      this->SetPathFromReferenceRemovingDotSegments(path);
-      query_ = query;
+      this->SetAuthority(components.authority, components.user_info, components.host,
+                         components.port);
+      this->SetPathFromReferenceRemovingDotSegments(std::string(path));
+      query_ = components.query;
     }
     else
     {
       if (path.empty())
       {
-        if (!query.empty())
-          query_ = query;
+        path_ = context.path_;
+        if (!components.query.empty())
+          query_ = components.query;
+        else
+          query_ = context.query_;
       }
       else
       {
         if (path[0] == '/')
-          this->SetPathFromReferenceRemovingDotSegments(path);
+          this->SetPathFromReferenceRemovingDotSegments(std::string(path));
         else
         {
-          std::string merged_path = this->MergePathWithReference(path);
-          this->SetPathFromReferenceRemovingDotSegments(merged_path);
+          this->SetPathFromReferenceRemovingDotSegments(context.MergePathWithReference(path));
         }
-        query_ = query;
+        query_ = components.query;
       }
+      this->SetAuthority(context.authority_, context.user_info_, context.host_, context.port_);
     }
+    scheme_ = context.scheme_;
   }
-  fragment_ = fragment;
+  fragment_ = components.fragment;
 }
 
 void
-Url::SetPathFromReferenceRemovingDotSegments(std::string & reference)
+Url::SetPathFromReferenceRemovingDotSegments(std::string reference)
 {
   path_.clear(); //Original path is cleared.
 
   if (reference.empty())
     return;
 
+  //Removing dot-segments never makes the path longer, so a single allocation is enough.
+  path_.reserve(reference.size());
+
   //In the search process for specific path segments, I could have used std::string::find with a
   //check against the current position: if (reference.find("../") == current_pos)
   //However, this would require a pass through the whole string (which could be a relatively long
@@ -403,7 +327,7 @@ Url::SetPathFromReferenceRemovingDotSegments(std::string & reference)
       //So even if current_pos is the last character of the string, adding 1 and using it as
       //below should just generate and std::string::npos return (no out of range exception).
       std::size_t next_pos = reference.find('/', static_cast<std::size_t>(current_pos + 1));
-      path_ += reference.substr(current_pos, next_pos - current_pos);//Either till the next slash
+      path_.append(reference, current_pos, next_pos - current_pos);//Either till the next slash
         //or till the end of the string.
       if (next_pos == std::string::npos)
         break;
@@ -421,28 +345,31 @@ Url::RemoveLastSegmentFromPath()
 }
 
 std::string
-Url::MergePathWithReference(std::string const& reference) const
+Url::MergePathWithReference(std::string_view reference) const
 {
   //If there's an authority, the path follows an hierarchical form. In this case, if the path is
   //empty, just concatenate a slash with the reference.
   if (!authority_.empty() && path_.empty())
-    return std::string("/" + reference);
+    return "/" + std::string(reference);
 
   std::size_t pos = path_.find_last_of('/');
   if (pos == std::string::npos)
     //Merge consists of only the reference. The entire path_ is excluded when no slash is found.
-    return reference;
+    return std::string(reference);
   else
   {
-    std::string merged(path_.substr(0, pos + 1)); //Keep the slash.
-    return merged + reference;
+    std::string merged;
+    merged.reserve(pos + 1 + reference.size());
+    merged.append(path_, 0, pos + 1); //Keep the slash.
+    merged += reference;
+    return merged;
   }
 }
 
 void
-Url::SetAuthority(std::string const& authority,
-                  std::string const& user_info,
-                  std::string const& host,
+Url::SetAuthority(std::string_view authority,
+                  std::string_view user_info,
+                  std::string_view host,
                   int port)
 {
   authority_ = authority;
@@ -468,6 +395,26 @@ bool operator!=(Url const& one, Url const& other)
   return !(one == other);
 }
 
+bool operator<(Url const& one, Url const& other)
+{
+  return Compare(one, other) < 0;
+}
+
+bool operator>(Url const& one, Url const& other)
+{
+  return other < one;
+}
+
+bool operator<=(Url const& one, Url const& other)
+{
+  return !(other < one);
+}
+
+bool operator>=(Url const& one, Url const& other)
+{
+  return !(one < other);
+}
+
 std::ostream & operator<<(std::ostream & out, Url const& url)
 {
   out << url.get_scheme() << ":";
@@ -27,6 +27,7 @@
 
 #include "config.hpp"
 #include <string>
+#include <string_view>
 #include <iosfwd>
 
 BUNDLE_NAMESPACE_BEGIN
@@ -43,19 +44,23 @@ BUNDLE_NAMESPACE_BEGIN
 class Url
 {
 public:
+  //The representation is only read during construction (it may point into any buffer). The
+  //components, on the other hand, are taken by value and moved into place.
+  Url(std::string_view representation);
   Url(std::string const& representation);
-  Url(std::string const& scheme,
-      std::string const& host,
-      std::string const& path,
-      std::string const& query = "",
-      std::string const& fragment = "");
-  Url(std::string const& scheme,
-      std::string const& host,
+  Url(char const* representation);
+  Url(std::string scheme,
+      std::string host,
+      std::string path,
+      std::string query = "",
+      std::string fragment = "");
+  Url(std::string scheme,
+      std::string host,
       int port,
-      std::string const& path,
-      std::string const& query = "",
-      std::string const& fragment = "");
-  Url(Url const& context, std::string const& representation);
+      std::string path,
+      std::string query = "",
+      std::string fragment = "");
+  Url(Url const& context, std::string_view representation);
 
 
   //Acessors and mutators.
@@ -72,40 +77,13 @@ public:
 
 private:
 
-  class UrlParser
-  {
-  public:
-    static void Execute(std::string const& representation,
-                        std::string & scheme,
-                        std::string & authority,
-                        std::string & user_info,
-                        std::string & host,
-                        int & port,
-                        std::string & path,
-                        std::string & query,
-                        std::string & fragment,
-                        bool relative_resolution);
-
-  private:
-    static void ExtractScheme(std::string const& representation,
-                              std::string & scheme,
-                              std::size_t & pos,
-                              bool relative_resolution);
-    static void ExtractAuthority(std::string const& representation,
-                                 std::string & authority,
-                                 std::string & user_info,
-                                 std::string & host,
-                                 int & port,
-                                 std::size_t & pos);
-  };
-
-  void ResolveRelativeness(Url const& context, std::string const& representation);
-  void SetPathFromReferenceRemovingDotSegments(std::string & reference);
-  std::string MergePathWithReference(std::string const& reference) const;
+  void ResolveRelativeness(Url const& context, std::string_view representation);
+  void SetPathFromReferenceRemovingDotSegments(std::string reference);
+  std::string MergePathWithReference(std::string_view reference) const;
   void RemoveLastSegmentFromPath();
-  void SetAuthority(std::string const& authority,
-                    std::string const& user_info,
-                    std::string const& host,
+  void SetAuthority(std::string_view authority,
+                    std::string_view user_info,
+                    std::string_view host,
                     int port);
 
   //Constants for relative resolution.
@@ -129,6 +107,13 @@ private:
 
 bool operator==(Url const&, Url const&);
 bool operator!=(Url const&, Url const&);
+
+//Total order, consistent with equality: scheme, host (compared label by label, from the top-level
+//domain down, so URLs of the same site end up together), port, path and query.
+bool operator<(Url const&, Url const&);
+bool operator>(Url const&, Url const&);
+bool operator<=(Url const&, Url const&);
+bool operator>=(Url const&, Url const&);
 std::ostream & operator<<(std::ostream &, Url const&);
 
 
@@ -0,0 +1,50 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#ifndef URL_CAPACITY_EXCEPTION_HPP
+#define URL_CAPACITY_EXCEPTION_HPP
+
+#include "config.hpp"
+#include "url_syntax_exception.hpp"
+
+BUNDLE_NAMESPACE_BEGIN
+
+/*
+ * Raised when a well-formed URL doesn't fit a fixed capacity (see BasicFixedUrl). Such a URL can
+ * still be held by a Url. It derives from UrlSyntaxException so that handlers of the latter keep
+ * rejecting it.
+ *
+ */
+
+
+class UrlCapacityException : public UrlSyntaxException
+{
+public:
+  UrlCapacityException(char const* msg):UrlSyntaxException(msg){}
+  virtual ~UrlCapacityException() throw() {}
+};
+
+NAMESPACE_END
+
+#endif //URL_CAPACITY_EXCEPTION_HPP
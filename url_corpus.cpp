@@ -0,0 +1,417 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#include "url_corpus.hpp"
+
+BUNDLE_NAMESPACE_BEGIN
+
+namespace
+{
+
+template <std::size_t N>
+std::size_t TableSize(char const* const (&)[N])
+{
+  return N;
+}
+
+char const* const kWebSchemes[] = { "http", "http", "https", "https", "https", "ftp" };
+char const* const kOpaqueSchemes[] = { "news", "mailto", "mailto", "urn", "tel" };
+char const* const kSubdomains[] = { "www", "www", "www", "m", "api", "cdn", "static", "blog",
+                                    "mail", "shop", "en", "docs" };
+char const* const kWords[] = { "news", "sports", "weather", "search", "images", "video", "login",
+                               "account", "products", "category", "item", "article", "story",
+                               "archive", "tag", "user", "profile", "help", "about", "contact",
+                               "download", "release", "forum", "thread", "comments", "page",
+                               "index", "en-us", "2009", "2024", "world", "business", "tech" };
+char const* const kDomains[] = { "example", "bla", "acme", "wikipedia", "github", "news-site",
+                                 "shop-online", "university", "cityguide", "travelinfo" };
+char const* const kTopLevel[] = { "com", "com", "com", "org", "net", "de", "co.uk", "com.br",
+                                  "io", "edu" };
+char const* const kExtensions[] = { ".html", ".htm", ".php", ".jpg", ".png", ".css", ".js",
+                                    ".pdf", ".xml" };
+char const* const kKeys[] = { "q", "id", "page", "lang", "sort", "ref", "utm_source",
+                              "utm_medium", "utm_campaign", "session", "s", "offset", "limit" };
+
+} //Anonymous namespace.
+
+UrlCorpusGenerator::UrlCorpusGenerator(unsigned long long seed) : state_(seed)
+{
+}
+
+std::vector<std::string>
+UrlCorpusGenerator::Generate(Kind kind, std::size_t count)
+{
+  std::vector<std::string> corpus;
+  corpus.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    corpus.push_back(this->GenerateOne(kind));
+  return corpus;
+}
+
+std::vector<std::string>
+UrlCorpusGenerator::GenerateDeepDotSegments(std::size_t count, std::size_t depth)
+{
+  std::vector<std::string> corpus;
+  corpus.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::string reference;
+    if (this->Next(4) == 0)
+      reference += "./";
+    for (std::size_t level = 0; level < depth; ++level)
+    {
+      reference += "../";
+      if (this->Next(8) == 0)
+      {
+        //A segment that is immediately cancelled, so the climbing is not a plain repetition.
+        this->AppendSegment(reference);
+        reference += "/../";
+      }
+    }
+    this->AppendSegment(reference);
+    reference += '/';
+    this->AppendSegment(reference);
+    if (this->Next(2) == 0)
+      this->AppendQuery(reference, 1 + this->Next(3));
+    corpus.push_back(reference);
+  }
+  return corpus;
+}
+
+std::string
+UrlCorpusGenerator::GenerateDeepBase(std::size_t depth)
+{
+  std::string base("http://");
+  this->AppendHost(base);
+  for (std::size_t level = 0; level < depth; ++level)
+  {
+    base += '/';
+    this->AppendSegment(base);
+  }
+  return base;
+}
+
+char const*
+UrlCorpusGenerator::KindName(Kind kind)
+{
+  switch (kind)
+  {
+  case SHORT_URLS:
+    return "short";
+  case LONG_URLS:
+    return "long";
+  case IPV6_URLS:
+    return "ipv6";
+  case OPAQUE_URLS:
+    return "opaque";
+  case MIXED_URLS:
+    return "mixed";
+  }
+  return "unknown";
+}
+
+bool
+UrlCorpusGenerator::KindFromName(std::string const& name, Kind & kind)
+{
+  static const Kind kinds[] = { SHORT_URLS, LONG_URLS, IPV6_URLS, OPAQUE_URLS, MIXED_URLS };
+  for (std::size_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); ++i)
+  {
+    if (name == KindName(kinds[i]))
+    {
+      kind = kinds[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string
+UrlCorpusGenerator::GenerateOne(Kind kind)
+{
+  switch (kind)
+  {
+  case SHORT_URLS:
+    return this->GenerateShort();
+  case LONG_URLS:
+    return this->GenerateLong();
+  case IPV6_URLS:
+    return this->GenerateIpv6();
+  case OPAQUE_URLS:
+    return this->GenerateOpaque();
+  case MIXED_URLS:
+  {
+    //Roughly what a crawler frontier looks like: mostly short, some long, a few oddities.
+    std::size_t roll = this->Next(100);
+    if (roll < 70)
+      return this->GenerateShort();
+    if (roll < 90)
+      return this->GenerateLong();
+    if (roll < 95)
+      return this->GenerateIpv6();
+    return this->GenerateOpaque();
+  }
+  }
+  return std::string();
+}
+
+std::string
+UrlCorpusGenerator::GenerateShort()
+{
+  std::string url(this->Pick(kWebSchemes, TableSize(kWebSchemes)));
+  url += "://";
+  this->AppendHost(url);
+  if (this->Next(10) == 0)
+  {
+    url += ':';
+    this->AppendNumber(url, 8000 + this->Next(1000));
+  }
+
+  std::size_t segments = this->Next(4);
+  for (std::size_t i = 0; i < segments; ++i)
+  {
+    url += '/';
+    this->AppendSegment(url);
+  }
+  if (segments == 0 || this->Next(3) == 0)
+    url += '/';
+  else if (this->Next(3) == 0)
+    url += this->Pick(kExtensions, TableSize(kExtensions));
+
+  if (this->Next(3) == 0)
+    this->AppendQuery(url, 1 + this->Next(2));
+  if (this->Next(10) == 0)
+  {
+    url += '#';
+    url += this->Pick(kWords, TableSize(kWords));
+  }
+  return url;
+}
+
+std::string
+UrlCorpusGenerator::GenerateLong()
+{
+  std::string url(this->Pick(kWebSchemes, TableSize(kWebSchemes)));
+  url += "://";
+  if (this->Next(5) == 0)
+  {
+    url += this->Pick(kWords, TableSize(kWords));
+    url += ":";
+    this->AppendHex(url, 8);
+    url += '@';
+  }
+  this->AppendHost(url);
+  if (this->Next(4) == 0)
+  {
+    url += ':';
+    this->AppendNumber(url, 1024 + this->Next(64000));
+  }
+
+  std::size_t segments = 8 + this->Next(13);
+  for (std::size_t i = 0; i < segments; ++i)
+  {
+    url += '/';
+    this->AppendSegment(url);
+  }
+  url += this->Pick(kExtensions, TableSize(kExtensions));
+  this->AppendQuery(url, 5 + this->Next(11));
+  if (this->Next(2) == 0)
+  {
+    url += '#';
+    this->AppendSegment(url);
+  }
+  return url;
+}
+
+std::string
+UrlCorpusGenerator::GenerateIpv6()
+{
+  std::string url(this->Pick(kWebSchemes, TableSize(kWebSchemes)));
+  url += "://[";
+  if (this->Next(2) == 0)
+  {
+    //Full form.
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      if (i)
+        url += ':';
+      this->AppendHex(url, 1 + this->Next(4));
+    }
+  }
+  else
+  {
+    //Compressed form, documentation prefix.
+    url += "2001:db8::";
+    this->AppendHex(url, 1 + this->Next(4));
+    url += ':';
+    this->AppendHex(url, 1 + this->Next(4));
+  }
+  url += ']';
+  if (this->Next(2) == 0)
+  {
+    url += ':';
+    this->AppendNumber(url, 1024 + this->Next(64000));
+  }
+
+  std::size_t segments = 1 + this->Next(4);
+  for (std::size_t i = 0; i < segments; ++i)
+  {
+    url += '/';
+    this->AppendSegment(url);
+  }
+  if (this->Next(3) == 0)
+    this->AppendQuery(url, 1 + this->Next(3));
+  return url;
+}
+
+std::string
+UrlCorpusGenerator::GenerateOpaque()
+{
+  std::string url(this->Pick(kOpaqueSchemes, TableSize(kOpaqueSchemes)));
+  url += ':';
+  if (url == "news:")
+  {
+    url += this->Pick(kWords, TableSize(kWords));
+    url += '.';
+    url += this->Pick(kWords, TableSize(kWords));
+    if (this->Next(2) == 0)
+    {
+      url += '.';
+      url += this->Pick(kWords, TableSize(kWords));
+    }
+  }
+  else if (url == "mailto:")
+  {
+    url += this->Pick(kWords, TableSize(kWords));
+    url += '.';
+    url += this->Pick(kWords, TableSize(kWords));
+    url += '@';
+    url += this->Pick(kDomains, TableSize(kDomains));
+    url += '.';
+    url += this->Pick(kTopLevel, TableSize(kTopLevel));
+    if (this->Next(4) == 0)
+    {
+      url += "?subject=";
+      url += this->Pick(kWords, TableSize(kWords));
+    }
+  }
+  else if (url == "urn:")
+  {
+    url += "isbn:";
+    this->AppendNumber(url, 1000000000ULL + this->Next(1000000000));
+  }
+  else
+  {
+    url += "+1-";
+    this->AppendNumber(url, 200 + this->Next(800));
+    url += '-';
+    this->AppendNumber(url, 1000000 + this->Next(9000000));
+  }
+  return url;
+}
+
+void
+UrlCorpusGenerator::AppendHost(std::string & url)
+{
+  if (this->Next(5) != 0)
+  {
+    url += this->Pick(kSubdomains, TableSize(kSubdomains));
+    url += '.';
+  }
+  url += this->Pick(kDomains, TableSize(kDomains));
+  url += '.';
+  url += this->Pick(kTopLevel, TableSize(kTopLevel));
+}
+
+void
+UrlCorpusGenerator::AppendSegment(std::string & url)
+{
+  url += this->Pick(kWords, TableSize(kWords));
+  switch (this->Next(6))
+  {
+  case 0:
+    url += '-';
+    url += this->Pick(kWords, TableSize(kWords));
+    break;
+  case 1:
+    this->AppendNumber(url, this->Next(100000));
+    break;
+  default:
+    break;
+  }
+}
+
+void
+UrlCorpusGenerator::AppendQuery(std::string & url, std::size_t parameters)
+{
+  url += '?';
+  for (std::size_t i = 0; i < parameters; ++i)
+  {
+    if (i)
+      url += '&';
+    url += this->Pick(kKeys, TableSize(kKeys));
+    url += '=';
+    if (this->Next(2) == 0)
+      url += this->Pick(kWords, TableSize(kWords));
+    else
+      this->AppendHex(url, 4 + this->Next(13));
+  }
+}
+
+void
+UrlCorpusGenerator::AppendHex(std::string & url, std::size_t digits)
+{
+  static const char hex[] = "0123456789abcdef";
+  for (std::size_t i = 0; i < digits; ++i)
+    url += hex[this->Next(16)];
+}
+
+void
+UrlCorpusGenerator::AppendNumber(std::string & url, unsigned long long value)
+{
+  char digits[24];
+  std::size_t count = 0;
+  do
+  {
+    digits[count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (count != 0)
+    url += digits[--count];
+}
+
+char const*
+UrlCorpusGenerator::Pick(char const* const* table, std::size_t size)
+{
+  return table[this->Next(size)];
+}
+
+std::size_t
+UrlCorpusGenerator::Next(std::size_t bound)
+{
+  //64-bit LCG (Knuth's MMIX constants). The high bits are the good ones, so use those.
+  state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+  return static_cast<std::size_t>((state_ >> 33) % bound);
+}
+
+NAMESPACE_END
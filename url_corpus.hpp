@@ -0,0 +1,90 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#ifndef URL_CORPUS_HPP
+#define URL_CORPUS_HPP
+
+#include "config.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+BUNDLE_NAMESPACE_BEGIN
+
+/*
+ * Class UrlCorpusGenerator
+ *
+ * Produces synthetic, but realistic looking, URLs for benchmarking. The generator carries its own
+ * pseudo-random engine (not the ones from <random>, whose distributions are implementation
+ * defined) so the same seed always yields the same corpus, regardless of platform or library.
+ */
+
+
+class UrlCorpusGenerator
+{
+public:
+  enum Kind
+  {
+    SHORT_URLS,  //Typical web URLs, mostly under 100 characters.
+    LONG_URLS,   //Deep paths and large queries, a few hundred characters.
+    IPV6_URLS,   //Authority with an IP-literal host.
+    OPAQUE_URLS, //No authority, like news: and mailto:.
+    MIXED_URLS   //A blend of all the above, weighted towards short ones.
+  };
+
+  explicit UrlCorpusGenerator(unsigned long long seed);
+
+  std::vector<std::string> Generate(Kind kind, std::size_t count);
+
+  //Relative references climbing depth levels with ../ (mixed with some ./ and x/../ noise).
+  std::vector<std::string> GenerateDeepDotSegments(std::size_t count, std::size_t depth);
+
+  //An absolute base URL whose path has depth segments, suitable for GenerateDeepDotSegments.
+  std::string GenerateDeepBase(std::size_t depth);
+
+  static char const* KindName(Kind kind);
+  static bool KindFromName(std::string const& name, Kind & kind);
+
+private:
+  std::string GenerateOne(Kind kind);
+  std::string GenerateShort();
+  std::string GenerateLong();
+  std::string GenerateIpv6();
+  std::string GenerateOpaque();
+
+  void AppendHost(std::string & url);
+  void AppendSegment(std::string & url);
+  void AppendQuery(std::string & url, std::size_t parameters);
+  void AppendHex(std::string & url, std::size_t digits);
+  void AppendNumber(std::string & url, unsigned long long value);
+  char const* Pick(char const* const* table, std::size_t size);
+  std::size_t Next(std::size_t bound);
+
+  unsigned long long state_;
+};
+
+
+NAMESPACE_END
+
+#endif //URL_CORPUS_HPP
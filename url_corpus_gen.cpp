@@ -0,0 +1,47 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "url_corpus.hpp"
+
+//Writes a synthetic corpus, one URL per line, so benchmark runs can be reproduced offline:
+//  url_corpus_gen <short|long|ipv6|opaque|mixed|deep> [count] [seed]
+//The output can be fed back into bench_url with --corpus. The exception is deep, which writes
+//relative references preceded by their base URL (on the first line), for --resolve-corpus.
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "usage: " << argv[0] << " <short|long|ipv6|opaque|mixed|deep> [count] [seed]"
+              << std::endl;
+    return 1;
+  }
+
+  std::string kind_name(argv[1]);
+  std::size_t count = argc > 2 ? std::strtoul(argv[2], 0, 10) : 10000;
+  unsigned long long seed = argc > 3 ? std::strtoull(argv[3], 0, 10) : 2009;
+
+  bundle::UrlCorpusGenerator generator(seed);
+  std::vector<std::string> corpus;
+  bundle::UrlCorpusGenerator::Kind kind;
+  if (kind_name == "deep")
+  {
+    //The base deep enough for every reference to climb all the way up.
+    const std::size_t depth = 16;
+    std::cout << generator.GenerateDeepBase(depth) << '\n';
+    corpus = generator.GenerateDeepDotSegments(count, depth);
+  }
+  else if (bundle::UrlCorpusGenerator::KindFromName(kind_name, kind))
+    corpus = generator.Generate(kind, count);
+  else
+  {
+    std::cerr << "unknown corpus kind: " << kind_name << std::endl;
+    return 1;
+  }
+
+  for (std::size_t i = 0; i < corpus.size(); ++i)
+    std::cout << corpus[i] << '\n';
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#include "url_parser.hpp"
+#include "url_syntax_exception.hpp"
+#include <cctype>
+
+BUNDLE_NAMESPACE_BEGIN
+
+void
+UrlParser::Execute(std::string_view representation,
+                   Components & components,
+                   bool relative_resolution)
+{
+  std::size_t current_pos = 0;
+
+  //Scheme...
+  UrlParser::ExtractScheme(representation, components.scheme, current_pos, relative_resolution);
+
+  //Authority...
+  UrlParser::ExtractAuthority(representation, components, current_pos);
+
+  if (current_pos == std::string_view::npos)
+    //In this case, the authority exists. However the URL has no path, query or fragment.
+    return;
+
+  //Path, query and fragment... (Notice that the initial slash is part of the path.)
+  std::size_t question_pos = representation.find('?', current_pos);
+  std::size_t square_pos = representation.find('#', current_pos);
+
+  if (question_pos != std::string_view::npos)
+  {
+    components.path = representation.substr(current_pos, question_pos - current_pos);
+    current_pos = question_pos + 1;
+    components.query = representation.substr(current_pos, square_pos - current_pos); //If
+      //square_pos is valid, the string is extracted as usual. Otherwise, just take it till the end
+      //anyway. Since the fragment is the last possible part of a URL, this behavior would be OK.
+  }
+  else
+    //The square_pos might be invalid here. However, for the same reason as above, taking the
+    //string till the end would be OK.
+    components.path = representation.substr(current_pos, square_pos - current_pos);
+
+  if (square_pos != std::string_view::npos)
+    components.fragment = representation.substr(square_pos + 1);
+}
+
+void
+UrlParser::ExtractScheme(std::string_view representation,
+                         std::string_view & scheme,
+                         std::size_t & current_pos,
+                         bool relative_resolution)
+{
+  //A scheme may or may not exist in a relative reference. In addition, according to section 4.2
+  //of RFC3986, the first path part of a relative reference may contain a colon. However, in this
+  //case it must start with a dot-segment (so it's not mistaken for a scheme name).
+  if (!representation.empty() && representation[0] == '.')
+  {
+    //There's no scheme to extract. Can only be a relative reference.
+    if (!relative_resolution)
+      throw UrlSyntaxException("Dot-segment preceding a scheme?");
+    else
+      return;
+  }
+  else
+  {
+    if ((current_pos = representation.find(':')) == std::string_view::npos)
+    {
+      if (!relative_resolution)
+        throw UrlSyntaxException("Scheme not found.");
+      else
+      {
+        current_pos = 0;
+        return;
+      }
+    }
+  }
+
+  scheme = representation.substr(0, current_pos++);
+  if (scheme.empty())
+    throw UrlSyntaxException("Scheme is empty.");
+}
+
+void
+UrlParser::ExtractAuthority(std::string_view representation,
+                            Components & components,
+                            std::size_t & current_pos)
+{
+  //Depending on the scheme, an authority may or may not exist (both for absolute URLs or for
+  //relative references). But when it exists, it's always preceded by the double-slash. (Unlike
+  //std::string, a string_view has no terminating null to stop at, so check the size first.)
+  if (representation.size() < current_pos + 2 ||
+      representation[current_pos] != '/' || representation[current_pos + 1] != '/')
+    //No authority. An URL like mailto:John.Doe@example.com or news:comp.lang.c++.
+    return;
+
+  std::size_t pos1 = current_pos + 2;
+
+  //Try to find a separator. First using slash, then question mark, then square. If none is found,
+  //take till the end of the string.
+  if ((current_pos = representation.find('/', pos1)) == std::string_view::npos &&
+      (current_pos = representation.find('?', pos1)) == std::string_view::npos)
+    current_pos = representation.find('#', pos1);
+  std::string_view authority = representation.substr(pos1, current_pos - pos1);
+
+  if (authority.empty())
+    throw UrlSyntaxException("Authority is empty.");
+  components.authority = authority;
+
+  //User info, host and port...
+  if ((pos1 = authority.find('@')) != std::string_view::npos)
+    components.user_info = authority.substr(0, pos1);
+
+  std::size_t pos2 = (pos1 == std::string_view::npos ? 0 : pos1 + 1); //0 or make it past the @.
+
+  //If host is surrounded by square brackets, it's an IP-literal (probably IPv6).
+  if (pos2 < authority.size() && authority[pos2] == '[')
+  {
+    if ((pos1 = authority.find(']')) == std::string_view::npos)
+      throw UrlSyntaxException("Unmatched square bracket in IP-literal.");
+
+    if ((pos1 = authority.find(':', pos1)) != std::string_view::npos)
+      components.port = UrlParser::ExtractPort(authority.substr(pos1 + 1));
+  }
+  else
+    if ((pos1 = authority.find(':', pos2)) != std::string_view::npos)
+      components.port = UrlParser::ExtractPort(authority.substr(pos1 + 1));
+
+  components.host = authority.substr(pos2, pos1 - pos2);
+}
+
+int
+UrlParser::ExtractPort(std::string_view digits)
+{
+  //Same conversion atoi would do, but atoi needs a null-terminated string (i.e., a copy).
+  std::size_t pos = 0;
+  while (pos < digits.size() && std::isspace(static_cast<unsigned char>(digits[pos])))
+    ++pos;
+
+  bool negative = false;
+  if (pos < digits.size() && (digits[pos] == '-' || digits[pos] == '+'))
+    negative = digits[pos++] == '-';
+
+  unsigned int port = 0; //Unsigned, so absurdly long ports wrap instead of overflowing.
+  for (; pos < digits.size() && digits[pos] >= '0' && digits[pos] <= '9'; ++pos)
+    port = port * 10 + static_cast<unsigned int>(digits[pos] - '0');
+  return static_cast<int>(negative ? 0u - port : port);
+}
+
+NAMESPACE_END
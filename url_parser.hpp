@@ -0,0 +1,78 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#ifndef URL_PARSER_HPP
+#define URL_PARSER_HPP
+
+#include "config.hpp"
+#include <cstddef>
+#include <string_view>
+
+BUNDLE_NAMESPACE_BEGIN
+
+/*
+ * Class UrlParser
+ *
+ * Splits a representation into its components without copying anything: every component is a
+ * view into the representation itself (which must outlive them). Both Url and BasicFixedUrl are
+ * built on top of it.
+ */
+
+
+class UrlParser
+{
+public:
+  struct Components
+  {
+    Components() : port(-1) {}
+
+    std::string_view scheme;
+    std::string_view authority;
+    std::string_view user_info;
+    std::string_view host;
+    int port; //-1 indicates default port.
+    std::string_view path;
+    std::string_view query;
+    std::string_view fragment;
+  };
+
+  static void Execute(std::string_view representation,
+                      Components & components,
+                      bool relative_resolution);
+
+private:
+  static void ExtractScheme(std::string_view representation,
+                            std::string_view & scheme,
+                            std::size_t & pos,
+                            bool relative_resolution);
+  static void ExtractAuthority(std::string_view representation,
+                               Components & components,
+                               std::size_t & pos);
+  static int ExtractPort(std::string_view digits);
+};
+
+
+NAMESPACE_END
+
+#endif //URL_PARSER_HPP
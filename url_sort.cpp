@@ -0,0 +1,716 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#include "url_sort.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+BUNDLE_NAMESPACE_BEGIN
+
+namespace
+{
+
+/*
+ * The key of a URL is the concatenation of its fields, in the order of operator<. Field contents
+ * are escaped so that bytes 0 and 1 are free to act as delimiters: 0 ends a field and 1 separates
+ * host labels (which are written from the top-level domain down). Since a delimiter is smaller than
+ * any content byte, comparing keys byte by byte is the same as comparing the fields one by one. The
+ * port is written as 4 big-endian bytes. Keys are prefix-free, so two URLs whose keys end within
+ * the same equal chunk are equal.
+ *
+ * Keys are never materialized. Each URL has a cursor that remembers where its key was left, and
+ * every chunk continues from there.
+ */
+enum KeyField
+{
+  SCHEME_FIELD,
+  HOST_FIELD,
+  PORT_FIELD,
+  PATH_FIELD,
+  QUERY_FIELD,
+  USER_INFO_FIELD,
+  AUTHORITY_FIELD,
+  KEY_END
+};
+
+struct KeyCursor
+{
+  std::uint32_t pos;       //Next content byte of the field (for the host, of the current label).
+  std::uint32_t label_end; //Host only: end of the current label.
+  unsigned char field;     //One of KeyField.
+  unsigned char pending;   //Second byte of an escape that didn't fit in the last chunk, or 0.
+};
+
+std::string_view FieldContent(Url const& url, unsigned char field)
+{
+  switch (field)
+  {
+  case SCHEME_FIELD:
+    return url.get_scheme();
+  case HOST_FIELD:
+    return url.get_host();
+  case PATH_FIELD:
+    return url.get_path();
+  case QUERY_FIELD:
+    return url.get_query();
+  case USER_INFO_FIELD:
+    return url.get_user_info();
+  case AUTHORITY_FIELD:
+    return url.get_authority();
+  }
+  return std::string_view();
+}
+
+//Start of the host label that ends at end.
+std::uint32_t LabelBegin(std::string_view host, std::uint32_t end)
+{
+  std::size_t dot = end == 0 ? std::string_view::npos : host.rfind('.', end - 1);
+  return dot == std::string_view::npos ? 0 : static_cast<std::uint32_t>(dot + 1);
+}
+
+void EnterField(Url const& url, KeyCursor & cursor, unsigned char field)
+{
+  cursor.field = field;
+  cursor.pos = 0;
+  cursor.pending = 0;
+  if (field == HOST_FIELD)
+  {
+    //The rightmost label comes first.
+    cursor.label_end = static_cast<std::uint32_t>(url.get_host().size());
+    cursor.pos = LabelBegin(url.get_host(), cursor.label_end);
+  }
+}
+
+std::uint64_t LoadBigEndian(char const* bytes)
+{
+  std::uint64_t value = 0;
+  for (int i = 0; i < 8; ++i)
+    value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+  return value;
+}
+
+//Whether any of the 8 bytes is 0, 1 or 2 (the ones that need escaping).
+bool HasEscapedByte(std::uint64_t bytes)
+{
+  return ((bytes - 0x0303030303030303ULL) & ~bytes & 0x8080808080808080ULL) != 0;
+}
+
+//Returns the next 8 key bytes of the URL (past the end of the key, zeros) and advances the cursor.
+std::uint64_t NextKeyChunk(Url const& url, KeyCursor & cursor)
+{
+  //Most chunks are just the next 8 bytes of a field.
+  if (!cursor.pending && cursor.field != PORT_FIELD && cursor.field != KEY_END)
+  {
+    std::string_view content = FieldContent(url, cursor.field);
+    std::uint32_t end =
+      cursor.field == HOST_FIELD ? cursor.label_end : static_cast<std::uint32_t>(content.size());
+    if (end - cursor.pos >= 8)
+    {
+      std::uint64_t chunk = LoadBigEndian(content.data() + cursor.pos);
+      if (!HasEscapedByte(chunk))
+      {
+        cursor.pos += 8;
+        return chunk;
+      }
+    }
+  }
+
+  std::uint64_t chunk = 0;
+  int filled = 0;
+  if (cursor.pending)
+  {
+    chunk = static_cast<std::uint64_t>(cursor.pending) << 56;
+    filled = 1;
+    cursor.pending = 0;
+  }
+
+  while (filled < 8 && cursor.field != KEY_END)
+  {
+    unsigned char byte;
+    if (cursor.field == PORT_FIELD)
+    {
+      //Flipping the sign bit makes the unsigned order match the signed one (-1 comes first).
+      std::uint32_t value = static_cast<std::uint32_t>(url.get_port()) ^ 0x80000000u;
+      byte = static_cast<unsigned char>(value >> (8 * (3 - cursor.pos)));
+      if (++cursor.pos == 4)
+        EnterField(url, cursor, PATH_FIELD);
+    }
+    else
+    {
+      std::string_view content = FieldContent(url, cursor.field);
+      std::uint32_t end =
+        cursor.field == HOST_FIELD ? cursor.label_end : static_cast<std::uint32_t>(content.size());
+
+      //Content bytes 0, 1 and 2 become 2 followed by 1, 2 and 3, which keeps their order.
+      while (filled < 8 && cursor.pos < end)
+      {
+        byte = static_cast<unsigned char>(content[cursor.pos++]);
+        if (byte <= 2)
+        {
+          chunk |= static_cast<std::uint64_t>(2) << (8 * (7 - filled++));
+          byte = static_cast<unsigned char>(byte + 1);
+          if (filled == 8)
+          {
+            cursor.pending = byte;
+            return chunk;
+          }
+        }
+        chunk |= static_cast<std::uint64_t>(byte) << (8 * (7 - filled++));
+      }
+      if (filled == 8)
+        break;
+
+      if (cursor.field == HOST_FIELD && LabelBegin(content, end) != 0)
+      {
+        byte = 1;
+        cursor.label_end = LabelBegin(content, end) - 1;
+        cursor.pos = LabelBegin(content, cursor.label_end);
+      }
+      else
+      {
+        byte = 0;
+        EnterField(url, cursor, static_cast<unsigned char>(cursor.field + 1));
+      }
+    }
+    chunk |= static_cast<std::uint64_t>(byte) << (8 * (7 - filled++));
+  }
+  return chunk;
+}
+
+//Below this size, a run is finished with comparisons (of what follows the shared chunks).
+const std::size_t small_run = 64;
+
+//So are runs split this many times (it bounds the recursion). Chunks shared by a whole run don't
+//split it, so a long common prefix doesn't count.
+const std::size_t max_depth = 64;
+
+//Below this size, sorting is not worth spawning threads.
+const std::size_t parallel_threshold = 1 << 16;
+
+template <class Function>
+void RunInParallel(unsigned threads, Function function)
+{
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t)
+    workers.emplace_back(function, t);
+  function(0u);
+  for (std::size_t t = 0; t < workers.size(); ++t)
+    workers[t].join();
+}
+
+struct Entry
+{
+  std::uint64_t key;
+  std::size_t index;
+};
+
+//LSD radix sort of the entries by key, one byte per pass. The counts of all passes are taken in
+//a single sweep, and passes in which all keys share the same byte are skipped.
+void RadixSortByKey(Entry * first, Entry * last, Entry * buffer)
+{
+  std::size_t size = last - first;
+  std::size_t counts[8][256] = {};
+  for (Entry * entry = first; entry != last; ++entry)
+    for (int digit = 0; digit < 8; ++digit)
+      ++counts[digit][(entry->key >> (8 * digit)) & 0xFF];
+
+  Entry * source = first;
+  Entry * target = buffer;
+  for (int digit = 0; digit < 8; ++digit)
+  {
+    std::size_t * count = counts[digit];
+    if (count[(first->key >> (8 * digit)) & 0xFF] == size)
+      continue;
+
+    std::size_t total = 0;
+    for (std::size_t bucket = 0; bucket < 256; ++bucket)
+    {
+      std::size_t bucket_count = count[bucket];
+      count[bucket] = total;
+      total += bucket_count;
+    }
+    for (Entry * entry = source; entry != source + size; ++entry)
+      target[count[(entry->key >> (8 * digit)) & 0xFF]++] = *entry;
+    std::swap(source, target);
+  }
+
+  if (source != first)
+    std::copy(source, source + size, first);
+}
+
+//Same as above, but each thread histograms and scatters its own block.
+void RadixSortByKey(Entry * first, Entry * last, Entry * buffer, unsigned threads)
+{
+  std::size_t size = last - first;
+  std::size_t block = (size + threads - 1) / threads;
+
+  //Which passes are needed doesn't depend on the order, so find that out up front.
+  std::vector<std::size_t> totals(static_cast<std::size_t>(threads) * 8 * 256);
+  RunInParallel(threads, [&](unsigned t) {
+    std::size_t * count = &totals[t * 8 * 256];
+    for (std::size_t i = t * block; i < std::min(size, (t + 1) * block); ++i)
+      for (int digit = 0; digit < 8; ++digit)
+        ++count[digit * 256 + ((first[i].key >> (8 * digit)) & 0xFF)];
+  });
+
+  std::vector<std::size_t> counts(static_cast<std::size_t>(threads) * 256);
+  Entry * source = first;
+  Entry * target = buffer;
+  for (int digit = 0; digit < 8; ++digit)
+  {
+    int shift = 8 * digit;
+    std::size_t first_bucket = (first->key >> shift) & 0xFF;
+    std::size_t first_bucket_total = 0;
+    for (unsigned t = 0; t < threads; ++t)
+      first_bucket_total += totals[(t * 8 + digit) * 256 + first_bucket];
+    if (first_bucket_total == size)
+      continue;
+
+    std::fill(counts.begin(), counts.end(), 0);
+    RunInParallel(threads, [&](unsigned t) {
+      std::size_t * count = &counts[t * 256];
+      for (std::size_t i = t * block; i < std::min(size, (t + 1) * block); ++i)
+        ++count[(source[i].key >> shift) & 0xFF];
+    });
+
+    //Turn the counts into the starting position of each (bucket, thread) pair.
+    std::size_t total = 0;
+    for (std::size_t bucket = 0; bucket < 256; ++bucket)
+    {
+      for (unsigned t = 0; t < threads; ++t)
+      {
+        std::size_t count = counts[t * 256 + bucket];
+        counts[t * 256 + bucket] = total;
+        total += count;
+      }
+    }
+
+    RunInParallel(threads, [&](unsigned t) {
+      std::size_t * position = &counts[t * 256];
+      for (std::size_t i = t * block; i < std::min(size, (t + 1) * block); ++i)
+        target[position[(source[i].key >> shift) & 0xFF]++] = source[i];
+    });
+    std::swap(source, target);
+  }
+
+  if (source != first)
+    std::copy(source, source + size, first);
+}
+
+
+//Sorts by key without materializing it: the first 8 bytes of every URL are radix sorted, then
+//each run of equal chunks is refined with the next 8 bytes, and so on. The entries are sorted
+//first, and the URLs are moved into place at the end.
+class RadixUrlSorter
+{
+public:
+  RadixUrlSorter(std::vector<Url> & urls, unsigned threads);
+
+  void Sort();
+
+private:
+  struct Run
+  {
+    std::size_t begin;
+    std::size_t end;
+    std::size_t depth; //Number of radix splits that led to the run.
+  };
+
+  void SortRun(Entry * first, Entry * last, Entry * buffer, std::size_t depth);
+  void SkipSharedChunks(Entry const* first, Entry const* last);
+  std::size_t CountSharedChunks(Entry const& reference, Entry const* first, Entry const* last);
+  void SkipChunks(Entry const* first, Entry const* last, std::size_t count);
+  void RefineInParallel(Run const& run, std::vector<Run> & runs);
+  void SortRunsInParallel(std::vector<Run> & runs);
+  void CollectRuns(std::size_t begin, std::size_t end, std::size_t depth, std::vector<Run> & runs);
+  void Permute();
+
+  bool KeyEnded(Entry const& entry) const { return cursors_[entry.index].field == KEY_END; }
+  bool KeyLess(Entry const& one, Entry const& other) const;
+
+  std::vector<Url> & urls_;
+  unsigned threads_;
+  std::vector<Entry> entries_;
+  std::vector<Entry> buffer_;
+  std::vector<KeyCursor> cursors_; //Indexed like the URLs, not like the entries.
+};
+
+RadixUrlSorter::RadixUrlSorter(std::vector<Url> & urls, unsigned threads) :
+  urls_(urls), threads_(threads), entries_(urls.size()), buffer_(urls.size()),
+  cursors_(urls.size())
+{
+  for (std::size_t i = 0; i < urls.size(); ++i)
+  {
+    entries_[i].index = i;
+    EnterField(urls[i], cursors_[i], SCHEME_FIELD);
+  }
+}
+
+void
+RadixUrlSorter::Sort()
+{
+  //The whole collection is a run that shares no chunk yet. Runs too big for one thread are
+  //refined by all of them, one chunk at a time, until they break into smaller runs. These are
+  //then spread among the threads.
+  std::vector<Run> big_runs(1, Run{ 0, urls_.size(), 0 });
+  std::vector<Run> small_runs;
+  while (!big_runs.empty())
+  {
+    std::vector<Run> runs;
+    for (std::size_t i = 0; i < big_runs.size(); ++i)
+    {
+      Run const& run = big_runs[i];
+      if (threads_ == 1 || run.end - run.begin < parallel_threshold || run.depth >= max_depth)
+        small_runs.push_back(run);
+      else
+        this->RefineInParallel(run, runs);
+    }
+    big_runs.swap(runs);
+  }
+  this->SortRunsInParallel(small_runs);
+  this->Permute();
+}
+
+//The entries share the key chunks read so far. Order them by what follows.
+void
+RadixUrlSorter::SortRun(Entry * first, Entry * last, Entry * buffer, std::size_t depth)
+{
+  if (this->KeyEnded(*first))
+    return; //Keys are prefix-free, so they are all the same key.
+
+  if (static_cast<std::size_t>(last - first) <= small_run || depth >= max_depth)
+  {
+    std::sort(first, last, [this](Entry const& one, Entry const& other) {
+      return this->KeyLess(one, other);
+    });
+    return;
+  }
+
+  //Chunks shared by the whole run need no sorting, just move past them.
+  this->SkipSharedChunks(first, last);
+  if (this->KeyEnded(*first))
+    return;
+
+  for (Entry * entry = first; entry != last; ++entry)
+    entry->key = NextKeyChunk(urls_[entry->index], cursors_[entry->index]);
+  RadixSortByKey(first, last, buffer);
+
+  while (first != last)
+  {
+    Entry * run_end = first + 1;
+    while (run_end != last && run_end->key == first->key)
+      ++run_end;
+    if (run_end - first > 1)
+      this->SortRun(first, run_end, buffer, depth + 1);
+    buffer += run_end - first;
+    first = run_end;
+  }
+}
+
+//Moves the cursors of all entries past the key chunks they all share. Each entry is read through in
+//one go, rather than the whole run one chunk at a time, so a long common prefix doesn't cost a
+//round of cache misses per chunk. Cursors are left where the entry stopped matching, which is only
+//redone for the entries before the one that set the final count.
+void
+RadixUrlSorter::SkipSharedChunks(Entry const* first, Entry const* last)
+{
+  Url const& reference_url = urls_[first->index];
+  KeyCursor reference_cursor = cursors_[first->index];
+  std::vector<std::uint64_t> reference_chunks;
+
+  std::vector<KeyCursor> originals;
+  originals.reserve(last - first);
+  originals.push_back(cursors_[first->index]);
+
+  std::size_t shared = static_cast<std::size_t>(-1);
+  Entry const* redo_end = first + 1;
+  for (Entry const* entry = first + 1; entry != last; ++entry)
+  {
+    KeyCursor & cursor = cursors_[entry->index];
+    originals.push_back(cursor);
+    std::size_t count = 0;
+    for (; count < shared; ++count)
+    {
+      if (count == reference_chunks.size())
+      {
+        if (reference_cursor.field == KEY_END)
+          break; //Matched the whole reference key.
+        reference_chunks.push_back(NextKeyChunk(reference_url, reference_cursor));
+      }
+      KeyCursor matched = cursor;
+      if (NextKeyChunk(urls_[entry->index], cursor) != reference_chunks[count])
+      {
+        cursor = matched;
+        break;
+      }
+    }
+    if (count < shared)
+    {
+      shared = count;
+      redo_end = entry;
+    }
+  }
+
+  //The reference itself, and the entries that went further than the final count.
+  for (Entry const* entry = first; entry != redo_end; ++entry)
+  {
+    cursors_[entry->index] = originals[entry - first];
+    this->SkipChunks(entry, entry + 1, shared);
+  }
+}
+
+//How many of the next key chunks all the entries share with the reference (no limit if there are
+//no entries). Like SkipSharedChunks, but without moving the cursors, so threads can count blocks
+//of a run separately.
+std::size_t
+RadixUrlSorter::CountSharedChunks(Entry const& reference, Entry const* first, Entry const* last)
+{
+  Url const& reference_url = urls_[reference.index];
+  KeyCursor reference_cursor = cursors_[reference.index];
+  std::vector<std::uint64_t> reference_chunks;
+
+  std::size_t shared = static_cast<std::size_t>(-1);
+  for (Entry const* entry = first; entry != last && shared != 0; ++entry)
+  {
+    KeyCursor cursor = cursors_[entry->index];
+    std::size_t count = 0;
+    for (; count < shared; ++count)
+    {
+      if (count == reference_chunks.size())
+      {
+        if (reference_cursor.field == KEY_END)
+          break; //Matched the whole reference key.
+        reference_chunks.push_back(NextKeyChunk(reference_url, reference_cursor));
+      }
+      if (NextKeyChunk(urls_[entry->index], cursor) != reference_chunks[count])
+        break;
+    }
+    shared = count;
+  }
+  return shared;
+}
+
+void
+RadixUrlSorter::SkipChunks(Entry const* first, Entry const* last, std::size_t count)
+{
+  for (Entry const* entry = first; entry != last; ++entry)
+    for (std::size_t i = 0; i < count; ++i)
+      NextKeyChunk(urls_[entry->index], cursors_[entry->index]);
+}
+
+//Same as operator<, for entries of the same run: their keys only differ after the cursors.
+bool
+RadixUrlSorter::KeyLess(Entry const& one, Entry const& other) const
+{
+  KeyCursor one_cursor = cursors_[one.index];
+  KeyCursor other_cursor = cursors_[other.index];
+  while (true)
+  {
+    std::uint64_t one_chunk = NextKeyChunk(urls_[one.index], one_cursor);
+    std::uint64_t other_chunk = NextKeyChunk(urls_[other.index], other_cursor);
+    if (one_chunk != other_chunk)
+      return one_chunk < other_chunk;
+    if (one_cursor.field == KEY_END)
+      return false; //Keys are prefix-free, so this is the same key.
+  }
+}
+
+void
+RadixUrlSorter::RefineInParallel(Run const& run, std::vector<Run> & runs)
+{
+  Entry * first = entries_.data() + run.begin;
+  Entry * last = entries_.data() + run.end;
+  if (this->KeyEnded(*first))
+    return;
+
+  //Chunks shared by the whole run are skipped as in SortRun, with each thread taking a block.
+  std::size_t size = last - first;
+  std::size_t block = (size + threads_ - 1) / threads_;
+  std::vector<std::size_t> shared(threads_, 0);
+  RunInParallel(threads_, [&](unsigned t) {
+    Entry * block_first = first + std::min(size, t * block);
+    Entry * block_last = first + std::min(size, (t + 1) * block);
+    shared[t] = this->CountSharedChunks(*first, std::max(block_first, first + 1), block_last);
+  });
+  std::size_t shared_chunks = *std::min_element(shared.begin(), shared.end());
+
+  RunInParallel(threads_, [&](unsigned t) {
+    Entry * block_first = first + std::min(size, t * block);
+    Entry * block_last = first + std::min(size, (t + 1) * block);
+    this->SkipChunks(block_first, block_last, shared_chunks);
+    for (Entry * entry = block_first; entry != block_last; ++entry)
+      entry->key = NextKeyChunk(urls_[entry->index], cursors_[entry->index]);
+  });
+
+  RadixSortByKey(first, last, buffer_.data() + run.begin, threads_);
+  this->CollectRuns(run.begin, run.end, run.depth + 1, runs);
+}
+
+void
+RadixUrlSorter::SortRunsInParallel(std::vector<Run> & runs)
+{
+  //Biggest first (they take the longest), picked up by the threads as they become free.
+  std::sort(runs.begin(), runs.end(), [](Run const& one, Run const& other) {
+    return one.end - one.begin > other.end - other.begin;
+  });
+
+  std::atomic<std::size_t> next_run(0);
+  unsigned workers = static_cast<unsigned>(std::min<std::size_t>(threads_, runs.size()));
+  RunInParallel(std::max(1u, workers), [&](unsigned) {
+    for (std::size_t run; (run = next_run.fetch_add(1)) < runs.size(); )
+    {
+      this->SortRun(entries_.data() + runs[run].begin,
+                    entries_.data() + runs[run].end,
+                    buffer_.data() + runs[run].begin,
+                    runs[run].depth);
+    }
+  });
+}
+
+void
+RadixUrlSorter::CollectRuns(std::size_t begin,
+                            std::size_t end,
+                            std::size_t depth,
+                            std::vector<Run> & runs)
+{
+  for (std::size_t run_end; begin < end; begin = run_end)
+  {
+    for (run_end = begin + 1; run_end < end && entries_[run_end].key == entries_[begin].key; )
+      ++run_end;
+    if (run_end - begin > 1)
+      runs.push_back(Run{ begin, run_end, depth });
+  }
+}
+
+void
+RadixUrlSorter::Permute()
+{
+  //Position i takes the URL at entries_[i].index. Follow each cycle of the permutation, so every
+  //URL is moved once and no second collection is needed. Done entries point to themselves.
+  for (std::size_t i = 0; i < entries_.size(); ++i)
+  {
+    if (entries_[i].index == i)
+      continue;
+
+    Url displaced(std::move(urls_[i]));
+    std::size_t position = i;
+    while (entries_[position].index != i)
+    {
+      std::size_t source = entries_[position].index;
+      urls_[position] = std::move(urls_[source]);
+      entries_[position].index = position;
+      position = source;
+    }
+    urls_[position] = std::move(displaced);
+    entries_[position].index = position;
+  }
+}
+
+} //Anonymous namespace.
+
+
+void SortUrls(std::vector<Url> & urls, unsigned threads)
+{
+  if (urls.size() < 2)
+    return;
+
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  if (urls.size() < parallel_threshold)
+    threads = 1;
+
+  RadixUrlSorter sorter(urls, threads);
+  sorter.Sort();
+}
+
+
+HostGroupIterator::HostGroupIterator(UrlIterator first, UrlIterator last) :
+  group_begin_(first), group_end_(first), last_(last)
+{
+  this->FindGroupEnd();
+}
+
+bool
+HostGroupIterator::AtEnd() const
+{
+  return group_begin_ == last_;
+}
+
+HostGroupIterator &
+HostGroupIterator::operator++()
+{
+  group_begin_ = group_end_;
+  this->FindGroupEnd();
+  return *this;
+}
+
+HostGroupIterator::UrlIterator
+HostGroupIterator::begin() const
+{
+  return group_begin_;
+}
+
+HostGroupIterator::UrlIterator
+HostGroupIterator::end() const
+{
+  return group_end_;
+}
+
+std::size_t
+HostGroupIterator::size() const
+{
+  return group_end_ - group_begin_;
+}
+
+std::string const&
+HostGroupIterator::get_scheme() const
+{
+  assert(!this->AtEnd());
+  return group_begin_->get_scheme();
+}
+
+std::string const&
+HostGroupIterator::get_host() const
+{
+  assert(!this->AtEnd());
+  return group_begin_->get_host();
+}
+
+void
+HostGroupIterator::FindGroupEnd()
+{
+  group_end_ = group_begin_;
+  while (group_end_ != last_ &&
+         group_end_->get_host() == group_begin_->get_host() &&
+         group_end_->get_scheme() == group_begin_->get_scheme())
+    ++group_end_;
+}
+
+NAMESPACE_END
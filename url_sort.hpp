@@ -0,0 +1,82 @@
+/*****************************************************************************
+ The MIT License
+
+ Copyright (c) since 2009 Leandro T. C. Melo
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*****************************************************************************/
+
+#ifndef URL_SORT_HPP
+#define URL_SORT_HPP
+
+#include "config.hpp"
+#include "url.hpp"
+#include <string>
+#include <vector>
+
+BUNDLE_NAMESPACE_BEGIN
+
+/*
+ * Sorts the URLs in place, in the order of operator<. Threads 0 means one per hardware thread.
+ */
+void SortUrls(std::vector<Url> & urls, unsigned threads = 0);
+
+
+/*
+ * Class HostGroupIterator
+ *
+ * Walks a range of URLs in groups of consecutive URLs with the same scheme and host. On a sorted
+ * range, each group holds every URL of a site (for a given scheme).
+ *
+ *   for (HostGroupIterator group(urls.begin(), urls.end()); !group.AtEnd(); ++group)
+ *     for (Url const& url : group)
+ *       ...
+ */
+
+
+class HostGroupIterator
+{
+public:
+  typedef std::vector<Url>::const_iterator UrlIterator;
+
+  HostGroupIterator(UrlIterator first, UrlIterator last);
+
+  bool AtEnd() const;
+  HostGroupIterator & operator++();
+
+  //The current group. When AtEnd(), it's empty and has no scheme or host (get_scheme() and
+  //get_host() must not be called).
+  UrlIterator begin() const;
+  UrlIterator end() const;
+  std::size_t size() const;
+  std::string const& get_scheme() const;
+  std::string const& get_host() const;
+
+private:
+  void FindGroupEnd();
+
+  UrlIterator group_begin_;
+  UrlIterator group_end_;
+  UrlIterator last_;
+};
+
+
+NAMESPACE_END
+
+#endif //URL_SORT_HPP
@@ -0,0 +1,157 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "fixed_url.hpp"
+#include "url_corpus.hpp"
+
+//Checks that BasicFixedUrl exposes the same components as Url, whether parsed from text or
+//converted from a Url, and that it rejects URLs over its capacity (only). Run by ctest. Exits
+//with 1 on the first failing case.
+
+namespace
+{
+
+template <std::size_t N>
+bool CheckSame(std::string const& name, bundle::BasicFixedUrl<N> const& fixed,
+               bundle::Url const& url)
+{
+  if (fixed.get_scheme() != url.get_scheme() ||
+      fixed.get_authority() != url.get_authority() ||
+      fixed.get_user_info() != url.get_user_info() ||
+      fixed.get_host() != url.get_host() ||
+      fixed.get_port() != url.get_port() ||
+      fixed.get_path() != url.get_path() ||
+      fixed.get_query() != url.get_query() ||
+      fixed.get_fragment() != url.get_fragment() ||
+      fixed.ToString() != url.ToString())
+  {
+    std::cerr << name << ": " << fixed << " differs from " << url << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//Parsing, converting from Url and back must all agree with Url. Over the capacity, both
+//constructors must raise a UrlCapacityException.
+template <std::size_t N>
+bool CheckUrl(std::string const& representation)
+{
+  bundle::Url url(representation);
+  try
+  {
+    bundle::BasicFixedUrl<N> parsed(representation);
+    bundle::BasicFixedUrl<N> converted(url);
+    bundle::Url back = parsed.ToUrl();
+    if (!CheckSame("parsed", parsed, url) ||
+        !CheckSame("converted", converted, url) ||
+        !CheckSame("back", parsed, back) ||
+        back != url)
+      return false;
+  }
+  catch (bundle::UrlCapacityException const&)
+  {
+    if (representation.size() <= N)
+    {
+      std::cerr << representation << ": rejected under the capacity of " << N << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  if (representation.size() > N)
+  {
+    std::cerr << representation << ": accepted over the capacity of " << N << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//URLs with IP-literal hosts, user info, ports and no authority at all.
+bool CheckShapes()
+{
+  static char const* const representations[] = {
+    "http://[::1]/", "http://[2001:db8::7]:8080/a?b#c", "http://u:p@example.com:81/a?q#f",
+    "ftp://anonymous@ftp.example.org/pub/", "mailto:john@example.com", "news:comp.lang.c++",
+    "urn:isbn:0451450523", "tel:+1-816-555-1212", "http://example.com", "http://example.com:/",
+    "http://example.com/?", "http://example.com/#", "a:"
+  };
+  for (std::size_t i = 0; i < sizeof(representations) / sizeof(representations[0]); ++i)
+  {
+    if (!CheckUrl<bundle::FixedUrl::capacity()>(representations[i]))
+      return false;
+  }
+  return true;
+}
+
+//Exactly N characters fit, N + 1 don't. The host-only URL makes sure user info and host, which
+//are inside the authority, are not counted twice when converting from Url.
+bool CheckCapacity()
+{
+  const std::size_t capacity = 64;
+  std::string prefix("http://u@example.com/");
+  for (std::size_t size = capacity - 1; size <= capacity + 1; ++size)
+  {
+    if (!CheckUrl<capacity>(prefix + std::string(size - prefix.size(), 'p')) ||
+        !CheckUrl<capacity>("http://" + std::string(size - 8, 'h') + "/"))
+      return false;
+  }
+  return true;
+}
+
+//A Url built from components keeps user info and host apart from (or inside) a made up
+//authority.
+bool CheckComponents()
+{
+  bundle::Url urls[] = {
+    bundle::Url("http", "example.com", "/a", "q", "f"),
+    bundle::Url("http", "example.com", 8080, "/a"),
+    bundle::Url("http", "example.com", -1, "/a")
+  };
+  for (std::size_t i = 0; i < sizeof(urls) / sizeof(urls[0]); ++i)
+  {
+    if (!CheckSame("components", bundle::FixedUrl(urls[i]), urls[i]))
+      return false;
+  }
+  return true;
+}
+
+//A malformed URL is a syntax error, not a capacity one.
+bool CheckMalformed()
+{
+  try
+  {
+    bundle::FixedUrl url("http://[::1/");
+  }
+  catch (bundle::UrlCapacityException const&)
+  {
+    std::cerr << "malformed URL rejected for its capacity" << std::endl;
+    return false;
+  }
+  catch (bundle::UrlSyntaxException const&)
+  {
+    return true;
+  }
+  std::cerr << "malformed URL accepted" << std::endl;
+  return false;
+}
+
+} //Anonymous namespace.
+
+
+int main()
+{
+  bundle::UrlCorpusGenerator generator(2009);
+  std::vector<std::string> corpus =
+    generator.Generate(bundle::UrlCorpusGenerator::MIXED_URLS, 20000);
+  for (std::size_t i = 0; i < corpus.size(); ++i)
+  {
+    if (!CheckUrl<bundle::FixedUrl::capacity()>(corpus[i]))
+      return 1;
+  }
+
+  if (!CheckShapes() || !CheckCapacity() || !CheckComponents() || !CheckMalformed())
+    return 1;
+
+  std::cout << "BasicFixedUrl agrees with Url" << std::endl;
+  return 0;
+}
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "url_corpus.hpp"
+#include "url_sort.hpp"
+
+//Checks that SortUrls agrees with std::sort over operator<, and that operator< is a total order
+//consistent with operator==. Run by ctest. Exits with 1 on the first failing case.
+
+namespace
+{
+
+//URLs whose keys exercise the escaping and delimiters of SortUrls.
+std::vector<bundle::Url> EdgeCases()
+{
+  static char const* const representations[] = {
+    "http://example.com/", "http://www.example.com/", "http://a.example.com/", "http://.com/",
+    "http://com/", "http://example.com./", "http://example..com/", "http://example.com:0/",
+    "http://example.com:80/", "http://example.com:/", "http://u@example.com/",
+    "http://v@example.com/", "http://example.com/a", "http://example.com/a?b",
+    "http://example.com/a?", "http://example.com/a#f", "http://[::1]/", "http://[::1]:8080/",
+    "https://example.com/", "http:/path", "mailto:a@b", "news:comp.lang.c++", "a:", "a:b"
+  };
+
+  std::vector<bundle::Url> urls;
+  for (std::size_t i = 0; i < sizeof(representations) / sizeof(representations[0]); ++i)
+    urls.push_back(bundle::Url(representations[i]));
+
+  //Bytes 0, 1 and 2 in host and path, which are escaped in the keys.
+  for (char byte = 0; byte <= 3; ++byte)
+  {
+    urls.push_back(bundle::Url(std::string("http://e") + byte + ".com/"));
+    urls.push_back(bundle::Url(std::string("http://e.com/") + byte));
+    urls.push_back(bundle::Url(std::string("http://e.com/") + byte + byte));
+    urls.push_back(bundle::Url(std::string("http://e.com") + byte + "/"));
+  }
+
+  //Built from components: port -1 vs 0, authority not derived from user info.
+  urls.push_back(bundle::Url("http", "example.com", "/"));
+  urls.push_back(bundle::Url("http", "example.com", 0, "/"));
+  urls.push_back(bundle::Url("http", "example.com", -1, "/"));
+
+  //Duplicates.
+  std::size_t size = urls.size();
+  for (std::size_t i = 0; i < size; ++i)
+    urls.push_back(urls[i]);
+  return urls;
+}
+
+//Same host and a long shared path prefix, so refinement goes many chunks deep.
+std::vector<bundle::Url> SharedPrefix(std::size_t count, std::size_t prefix)
+{
+  bundle::UrlCorpusGenerator generator(7);
+  std::vector<std::string> suffixes =
+    generator.Generate(bundle::UrlCorpusGenerator::SHORT_URLS, count);
+  std::vector<bundle::Url> urls;
+  for (std::size_t i = 0; i < count; ++i)
+    urls.push_back(bundle::Url("http://www.example.com/" + std::string(prefix, 'p') +
+                               suffixes[i].substr(suffixes[i].find("//") + 2)));
+  return urls;
+}
+
+bool CheckOrder(char const* name, std::vector<bundle::Url> const& urls)
+{
+  for (std::size_t i = 0; i < urls.size(); i += 1 + i / 64)
+  {
+    for (std::size_t j = 0; j < urls.size(); j += 1 + j / 64)
+    {
+      bundle::Url const& one = urls[i];
+      bundle::Url const& other = urls[j];
+      if ((one < other && other < one) || ((!(one < other) && !(other < one)) != (one == other)))
+      {
+        std::cerr << name << ": inconsistent order for " << one << " and " << other << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckHostGroups(char const* name, std::vector<bundle::Url> const& sorted)
+{
+  std::size_t grouped = 0;
+  for (bundle::HostGroupIterator group(sorted.begin(), sorted.end()); !group.AtEnd(); ++group)
+  {
+    for (bundle::Url const& url : group)
+    {
+      if (url.get_scheme() != group.get_scheme() || url.get_host() != group.get_host())
+      {
+        std::cerr << name << ": " << url << " grouped under " << group.get_scheme() << "://"
+                  << group.get_host() << std::endl;
+        return false;
+      }
+    }
+    grouped += group.size();
+
+    //Adjacent groups of the same site would mean it was split (on a sorted range).
+    if (group.end() != sorted.end() &&
+        group.end()->get_scheme() == group.get_scheme() &&
+        group.end()->get_host() == group.get_host())
+    {
+      std::cerr << name << ": " << *group.end() << " split from its group" << std::endl;
+      return false;
+    }
+  }
+  if (grouped != sorted.size())
+  {
+    std::cerr << name << ": host groups miss URLs" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> SortedFragments(std::vector<bundle::Url> const& urls)
+{
+  std::vector<std::string> fragments;
+  for (std::size_t i = 0; i < urls.size(); ++i)
+    fragments.push_back(urls[i].get_fragment());
+  std::sort(fragments.begin(), fragments.end());
+  return fragments;
+}
+
+bool CheckSort(char const* name, std::vector<bundle::Url> const& urls)
+{
+  std::vector<bundle::Url> expected(urls);
+  std::sort(expected.begin(), expected.end());
+  std::vector<std::string> fragments = SortedFragments(urls);
+
+  static const unsigned threads[] = { 1, 2, 4, 0 };
+  for (std::size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+  {
+    std::vector<bundle::Url> sorted(urls);
+    bundle::SortUrls(sorted, threads[t]);
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      if (sorted[i] != expected[i])
+      {
+        std::cerr << name << " (" << threads[t] << " threads): position " << i << " has "
+                  << sorted[i] << " instead of " << expected[i] << std::endl;
+        return false;
+      }
+    }
+
+    //Equal URLs may still differ in the fragment (which == ignores). Make sure none was lost or
+    //duplicated in the moves.
+    if (SortedFragments(sorted) != fragments)
+    {
+      std::cerr << name << " (" << threads[t] << " threads): URLs lost in sorting" << std::endl;
+      return false;
+    }
+    if (!CheckHostGroups(name, sorted))
+      return false;
+  }
+  return true;
+}
+
+} //Anonymous namespace.
+
+
+int main()
+{
+  std::vector<bundle::Url> edge_cases = EdgeCases();
+
+  bundle::UrlCorpusGenerator generator(2009);
+  std::vector<std::string> corpus =
+    generator.Generate(bundle::UrlCorpusGenerator::MIXED_URLS, 70000);
+  std::vector<bundle::Url> mixed(corpus.begin(), corpus.end());
+  mixed.insert(mixed.end(), edge_cases.begin(), edge_cases.end());
+
+  //Large enough for the parallel paths.
+  std::vector<bundle::Url> shared_prefix = SharedPrefix(70000, 400);
+
+  //The last http host is the first https one, so the two sites are adjacent once sorted.
+  std::vector<bundle::Url> schemes;
+  schemes.push_back(bundle::Url("https://a.com/b"));
+  schemes.push_back(bundle::Url("https://a.com/"));
+  schemes.push_back(bundle::Url("http://a.com/"));
+
+  if (!CheckOrder("edge cases", edge_cases) || !CheckOrder("mixed", mixed))
+    return 1;
+
+  if (!CheckSort("schemes", schemes) ||
+      !CheckSort("edge cases", edge_cases) ||
+      !CheckSort("mixed", mixed) ||
+      !CheckSort("shared prefix", shared_prefix))
+    return 1;
+
+  std::cout << "SortUrls agrees with std::sort" << std::endl;
+  return 0;
+}